@@ -3,14 +3,48 @@
 // <!> Warning: must compile with compiler flag -std=c++17
 
 #include <iostream>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <cctype>
+#include <cerrno>
+#include <charconv>
+#include <chrono>
 #include <cstdlib>
 #include <cstdint>
+#include <cstddef>
+#include <cstring>
+#include <deque>
+#include <filesystem>
+#include <functional>
+#include <limits>
+#include <locale>
+#include <memory_resource>
+#include <mutex>
 #include <string>
+#include <string_view>
 #include <optional>
 #include <system_error>
+#include <thread>
+#include <tuple>
+#include <type_traits>
+#include <typeinfo>
+#include <unordered_map>
 #include <variant>
 #include <vector>
+#define NOMINMAX // Otherwise the 'min'/'max' macros of 'windows.h' break 'std::min' and 'numeric_limits<T>::max()'
 #include <windows.h>
+#include "../common/bench.h" // '--benchmark' harness and data generators; compiled out unless -DENABLE_BENCHMARK
+#include "../common/output.h" // Buffered text/CSV/binary reports
+#include "../common/snapshot.h" // Binary snapshots loaded by memory mapping
+#include "../common/reduce.h" // Slicing of 'CreateBatch' across the worker pool
+
+#ifndef _WIN32
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif // _WIN32
 
 #if __cplusplus >= 202002L
   #include <span>
@@ -19,6 +53,14 @@
   #define SUPPORTS_CPP20 0
 #endif // __cplusplus
 
+// Compile with '-mavx2' (or '-march=native') to enable the vectorized column checks.
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define SUPPORTS_AVX2 1
+#else
+  #define SUPPORTS_AVX2 0
+#endif // __AVX2__
+
 // 'std::string_view': Any function that only needs to read the string without taking ownership or modifying it.
 
 // Strong typedef to prevent accidental misuse.
@@ -32,19 +74,67 @@ enum class ValidationError {
   EmptyCity,
   InvalidPostalCode,
   EmptyName,
-  InvalidAge
+  InvalidAge,
+  MalformedRecord
 };
 
-struct ErrorReport {
-  ValidationError error;
-  std::string context;
-  std::string message;
+// Declarative validation rules. Each rule is a type whose 'Check' is 'constexpr', and a 'RuleTable'
+// lists one rule per field in the same order as the factory arguments, so the validators are
+// generated at compile time with no runtime dispatch, and fold to constants for literal inputs.
+template<ValidationError Error>
+struct NonEmptyRule {
+  static constexpr ValidationError kError{Error};
 
-  void Log() const {
-    Validator::HandleValidationFailure(error, context, message);
+  static constexpr bool Check(std::string_view value) noexcept { return !value.empty(); }
+};
+
+template<typename T, T Min, T Max, ValidationError Error>
+struct RangeRule {
+  static_assert(Min <= Max, "Empty range.");
+  static constexpr ValidationError kError{Error};
+  static constexpr T kMin{Min};
+  static constexpr T kMax{Max};
+
+  // One unsigned compare instead of two: values below 'Min' wrap around to large numbers.
+  static constexpr bool Check(T value) noexcept {
+    using Wide = std::conditional_t<(sizeof(T) < sizeof(unsigned int)), unsigned int, std::make_unsigned_t<T>>;
+    return static_cast<Wide>(static_cast<Wide>(value) - static_cast<Wide>(Min)) <= static_cast<Wide>(Max - Min);
+  }
+};
+
+template<typename... Rules>
+struct RuleTable {
+  // The first failing rule wins, left to right, like the hand-written checks it replaces.
+  template<typename... Fields>
+  static constexpr std::optional<ValidationError> Check(const Fields&... fields) noexcept {
+    static_assert(sizeof...(Fields) == sizeof...(Rules), "A rule table needs exactly one field per rule.");
+    ValidationError error{ValidationError::None};
+    (void)((Rules::Check(fields) || (error = Rules::kError, false)) && ...);
+    return error == ValidationError::None ? std::nullopt : std::optional<ValidationError>(error);
   }
 };
 
+// Per-deployment rule sets: derive from 'DefaultRuleSet' and shadow the rules that differ, then
+// point 'Config::RuleSet' at it. The error messages in 'Validator' describe the default rules.
+struct DefaultRuleSet {
+  using StreetRule = NonEmptyRule<ValidationError::EmptyStreet>;
+  using CityRule = NonEmptyRule<ValidationError::EmptyCity>;
+  using PostalCodeRule = RangeRule<PostalCode, 1, 99'950, ValidationError::InvalidPostalCode>;
+  using NameRule = NonEmptyRule<ValidationError::EmptyName>;
+  using AgeRule = RangeRule<Age, 1, 120, ValidationError::InvalidAge>;
+};
+
+// E.g.: Cyprus uses 4-digit postal codes.
+struct CyprusRuleSet : DefaultRuleSet {
+  using PostalCodeRule = RangeRule<PostalCode, 1'000, 9'999, ValidationError::InvalidPostalCode>;
+};
+
+template<typename RuleSet>
+using AddressRules = RuleTable<typename RuleSet::StreetRule, typename RuleSet::CityRule, typename RuleSet::PostalCodeRule>;
+
+template<typename RuleSet>
+using PersonRules = RuleTable<typename RuleSet::NameRule, typename RuleSet::AgeRule>;
+
 namespace Config {
   // Do not use 'if constexpr' if I wanted to implement runtime toggling in the future.
   constexpr bool DEVELOPER_MODE{false};
@@ -53,6 +143,19 @@ namespace Config {
   
   // Maximum length for log entries before truncation.
   constexpr std::uint16_t MAX_LOG_LENGTH{50};
+
+  // Number of pending failure records the validation log can hold (must be a power of two).
+  constexpr std::size_t LOG_RING_CAPACITY{1'024};
+
+  // Smallest slice of a batch worth handing to its own worker thread in 'CreateBatch'.
+  constexpr std::size_t BATCH_MIN_ROWS_PER_WORKER{4'096};
+
+  // Size of each mapped window when streaming input files, and rows per 'CreateBatch' call while ingesting.
+  constexpr std::uint64_t INGEST_WINDOW_BYTES{64ULL * 1'024 * 1'024};
+  constexpr std::size_t INGEST_BATCH_ROWS{1 << 16};
+
+  // Rules used by the factories; swap for another rule set per deployment.
+  using RuleSet = DefaultRuleSet;
 }
 
 template<typename T>
@@ -73,42 +176,200 @@ std::string CleanTypeName() {
 // For C++20, use constexpr lambda below:
 // constexpr auto isValidPostalCode = [](int code) { return code >= 1 && code <= 99950; };
 constexpr bool IsValidPostalCode(PostalCode postal_code) { // Compile-time optimization
-  return postal_code >= 1 && postal_code <= 99950;
+  return Config::RuleSet::PostalCodeRule::Check(postal_code);
 }
 
-class Validator {
+class Address;
+class AddressTable;
+class AddressTableView;
+
+// Result of validating a whole 'AddressTable': one bit per row and per rule, where a set bit
+// means that row breaks the rule. 1M rows cost ~375 KiB instead of a 'std::vector<ValidationError>'.
+struct ValidationBitmap {
+  using Word = std::uint64_t;
+  static constexpr std::size_t kBitsPerWord{64};
+
+  std::size_t rows{0};
+  std::vector<Word> empty_street;
+  std::vector<Word> empty_city;
+  std::vector<Word> invalid_postal_code;
+
+  static constexpr std::size_t WordsFor(std::size_t rows) noexcept {
+    return (rows + kBitsPerWord - 1) / kBitsPerWord;
+  }
+
+  static bool Test(const std::vector<Word>& bits, std::size_t row) noexcept {
+    return (bits[row / kBitsPerWord] >> (row % kBitsPerWord)) & 1U;
+  }
+
+  // Same priority as 'Validator::ValidateAddress', so both paths report the same error per row.
+  std::optional<ValidationError> ErrorAt(std::size_t row) const noexcept {
+    if (Test(empty_street, row)) return ValidationError::EmptyStreet;
+    if (Test(empty_city, row)) return ValidationError::EmptyCity;
+    if (Test(invalid_postal_code, row)) return ValidationError::InvalidPostalCode;
+    return std::nullopt;
+  }
+
+  std::size_t CountFailures() const noexcept {
+    std::size_t failures{0};
+    for (std::size_t i{0}; i < empty_street.size(); ++i) {
+      failures += PopCount(empty_street[i] | empty_city[i] | invalid_postal_code[i]);
+    }
+    return failures;
+  }
+
+  private:
+    static std::size_t PopCount(Word word) noexcept {
+      #if defined(__GNUC__) || defined(__clang__)
+        return static_cast<std::size_t>(__builtin_popcountll(word));
+      #else
+        std::size_t count{0};
+        for (; word; word &= word - 1) ++count;
+        return count;
+      #endif
+    }
+};
+
+// Fixed-size failure record: no heap memory, so it can be written on the validation hot path.
+struct ValidationLogRecord {
+  ValidationError error;
+  std::chrono::steady_clock::duration timestamp; // Since the log was started
+  std::uint8_t context_length;
+  std::uint8_t info_length;
+  bool context_truncated;
+  bool info_truncated;
+  char context[Config::MAX_LOG_LENGTH];
+  char info[Config::MAX_LOG_LENGTH];
+};
+
+// Structured sink for 'Validator::HandleValidationFailure'. Producers copy a record into a preallocated
+// lock-free ring (bounded MPMC queue with per-slot sequence numbers) and return immediately; a
+// background thread drains the ring and does the actual 'std::cerr' formatting. When the ring is full the
+// record is dropped and counted, so a burst of bad data can never block or allocate in the validators.
+class ValidationLog {
   public:
-    static std::optional<ValidationError> ValidateAddress(std::string_view street, std::string_view city, PostalCode postal_code) {
-      if (street.empty()) return ValidationError::EmptyStreet;
-      if (city.empty()) return ValidationError::EmptyCity;
-      if (!IsValidPostalCode(postal_code)) return ValidationError::InvalidPostalCode;
-      return std::nullopt; // Validation successful
+    static_assert((Config::LOG_RING_CAPACITY & (Config::LOG_RING_CAPACITY - 1)) == 0,
+                  "Config::LOG_RING_CAPACITY must be a power of two.");
+    static_assert(Config::MAX_LOG_LENGTH <= std::numeric_limits<std::uint8_t>::max(),
+                  "Record lengths are stored in one byte.");
+
+    // Started on first use; the destructor (at exit) drains what is left and joins the thread.
+    static ValidationLog& Instance() {
+      static ValidationLog log;
+      return log;
     }
-    
-    #if SUPPORTS_CPP20
-      static std::optional<ValidationError> ValidateBatchAddresses(std::span<const Address> addresses) {
-        for (const auto& address : addresses) {
-          if (auto error = ValidateAddress(address.GetStreet(), address.GetCity(), ))
+
+    ValidationLog(const ValidationLog&) = delete;
+    ValidationLog& operator=(const ValidationLog&) = delete;
+
+    ~ValidationLog() {
+      m_running.store(false, std::memory_order_release);
+      if (m_drainer.joinable()) m_drainer.join();
+    }
+
+    bool TryPush(ValidationError error, std::string_view context, std::string_view info, std::size_t max_length) noexcept {
+      std::size_t position{m_enqueue_position.load(std::memory_order_relaxed)};
+      Slot* slot{nullptr};
+
+      for (;;) {
+        slot = &m_slots[position & kMask];
+        const std::size_t sequence{slot->sequence.load(std::memory_order_acquire)};
+        const auto difference = static_cast<std::ptrdiff_t>(sequence - position);
+
+        if (difference == 0) {
+          if (m_enqueue_position.compare_exchange_weak(position, position + 1, std::memory_order_relaxed)) break;
+        } else if (difference < 0) {
+          m_dropped.fetch_add(1, std::memory_order_relaxed); // Ring is full
+          return false;
+        } else {
+          position = m_enqueue_position.load(std::memory_order_relaxed);
         }
       }
-    #else
-        std::vector<ValidationError> ValidateBatchAddresses(const std::vector<Address>& addresses) {
-        std::vector<ValidationError> errors;
 
-        for (const auto& address : addresses) {
-            if (auto error = Validator::ValidateAddress(address.GetStreet(), address.GetCity(), address.GetPostalCode())) {
-                errors.push_back(*error);
-            }
-        }
+      ValidationLogRecord& record{slot->record};
+      record.error = error;
+      record.timestamp = std::chrono::steady_clock::now() - m_start;
+      const std::size_t limit{std::min<std::size_t>(max_length, Config::MAX_LOG_LENGTH)};
+      CopyTruncated(context, limit, record.context, record.context_length, record.context_truncated);
+      CopyTruncated(info, limit, record.info, record.info_length, record.info_truncated);
+
+      slot->sequence.store(position + 1, std::memory_order_release); // Publish to the drainer
+      return true;
+    }
+
+    std::size_t DroppedRecords() const noexcept { return m_dropped.load(std::memory_order_relaxed); }
+
+  private:
+    static constexpr std::size_t kMask{Config::LOG_RING_CAPACITY - 1};
 
-        return errors;
+    struct Slot {
+      std::atomic<std::size_t> sequence;
+      ValidationLogRecord record;
+    };
+
+    ValidationLog() : m_start(std::chrono::steady_clock::now()) {
+      for (std::size_t i{0}; i < m_slots.size(); ++i) {
+        m_slots[i].sequence.store(i, std::memory_order_relaxed);
       }
+      m_drainer = std::thread([this] { Drain(); });
+    }
+
+    static void CopyTruncated(std::string_view input, std::size_t limit, char* out, std::uint8_t& length, bool& truncated) noexcept {
+      const std::size_t size{std::min(input.size(), limit)};
+      std::memcpy(out, input.data(), size);
+      length = static_cast<std::uint8_t>(size);
+      truncated = input.size() > limit;
+    }
+
+    // Only called from the drainer thread, so the dequeue side needs no atomics of its own.
+    bool TryPop(ValidationLogRecord& out) noexcept {
+      Slot& slot{m_slots[m_dequeue_position & kMask]};
+      if (slot.sequence.load(std::memory_order_acquire) != m_dequeue_position + 1) return false;
+
+      out = slot.record;
+      slot.sequence.store(m_dequeue_position + Config::LOG_RING_CAPACITY, std::memory_order_release);
+      ++m_dequeue_position;
+      return true;
+    }
+
+    void Drain();
+    static void Print(const ValidationLogRecord& record);
+
+    const std::chrono::steady_clock::time_point m_start;
+    std::array<Slot, Config::LOG_RING_CAPACITY> m_slots;
+    alignas(64) std::atomic<std::size_t> m_enqueue_position{0}; // Own cache line: contended by producers
+    alignas(64) std::size_t m_dequeue_position{0};
+    std::atomic<std::size_t> m_dropped{0};
+    std::atomic<bool> m_running{true};
+    std::thread m_drainer;
+};
+
+class Validator {
+  public:
+    // 'constexpr', so literal inputs can be checked with 'static_assert' (see 'main').
+    template<typename RuleSet = Config::RuleSet>
+    static constexpr std::optional<ValidationError> ValidateAddress(std::string_view street, std::string_view city, PostalCode postal_code) {
+      return AddressRules<RuleSet>::Check(street, city, postal_code); // 'std::nullopt' if validation succeeds
+    }
+    
+    // Defined after 'Address', which must be a complete type here.
+    #if SUPPORTS_CPP20
+      static std::vector<ValidationError> ValidateBatchAddresses(std::span<const Address> addresses);
+    #else
+      static std::vector<ValidationError> ValidateBatchAddresses(const std::vector<Address>& addresses);
     #endif // SUPPORTS_CPP20
 
-    static std::optional<ValidationError> ValidatePerson(std::string_view name, const Age age) {
-      if (name.empty()) return ValidationError::EmptyName;
-      if (age == 0 || age > 120) return ValidationError::InvalidAge;
-      return std::nullopt; // Validation successful
+    // Column-wise counterpart of 'ValidateBatchAddresses' for bulk ingest; defined after 'AddressTable'.
+    template<typename RuleSet = Config::RuleSet>
+    static ValidationBitmap ValidateAddressTable(const AddressTable& table);
+
+    // The same kernel over a table mapped from a snapshot.
+    template<typename RuleSet = Config::RuleSet>
+    static ValidationBitmap ValidateAddressTable(const AddressTableView& table);
+
+    template<typename RuleSet = Config::RuleSet>
+    static constexpr std::optional<ValidationError> ValidatePerson(std::string_view name, const Age age) {
+      return PersonRules<RuleSet>::Check(name, age); // 'std::nullopt' if validation succeeds
     }
 
     static void HandleValidationFailure(
@@ -117,34 +378,88 @@ class Validator {
         std::string_view additional_info = "",
         LogEntryMaxLength max_length = 100) // Default maximum length for context and info
     {
-      // Map ValidationError to error message
-      std::string error_message = GetErrorMessage(error);
-      
-      auto Truncate = [max_length](std::string_view input) -> std::string {
-        if (input.length() > max_length) {
-          return std::string(input.substr(0, max_length)) + "..."; // Add ellipsis to indicate truncation
-        }
-        return std::string(input);
-      };
-
+      // Nothing is built or copied unless logging is compiled in; the record is formatted off-thread.
       if constexpr (Config::DEBUG_MODE) {
-          std::cerr << "[Validation Failure] " << error_message;
-          if (!context.empty()) std::cerr << " | Context: " << Truncate(context);
-          if (!additional_info.empty()) std::cerr << " | Info: " << Truncate(additional_info);
-          std::cerr << '\n';
+        ValidationLog::Instance().TryPush(error, context, additional_info, max_length);
       }
     }
 
-    static std::string GetErrorMessage(ValidationError error) {
-      switch (error) {
-        case ValidationError::EmptyStreet: return "Street cannot be empty.";
-        case ValidationError::EmptyCity: return "City cannot be empty.";
-        case ValidationError::InvalidPostalCode: return "Postal code must be between 1 and 99950.";
-        case ValidationError::EmptyName: return "Name cannot be empty.";
-        case ValidationError::InvalidAge: return "Age must be between 1 and 120.";
-        default: return "Unknown validation error.";
+    // Same, for a failure at 'line_number' of the file 'context': "Line N" is formatted on the stack,
+    // and only when logging is compiled in.
+    static void HandleValidationFailure(ValidationError error, std::string_view context, std::size_t line_number) {
+      if constexpr (Config::DEBUG_MODE) {
+        char info[32]{"Line "};
+        const char* end{std::to_chars(info + 5, info + sizeof(info), line_number).ptr};
+        HandleValidationFailure(error, context, std::string_view(info, static_cast<std::size_t>(end - info)));
       }
     }
+
+    // Indexed by 'ValidationError'; entry 0 ('None') doubles as the fallback for unknown values.
+    static constexpr std::string_view kErrorMessages[]{
+      "Unknown validation error.",
+      "Street cannot be empty.",
+      "City cannot be empty.",
+      "Postal code must be between 1 and 99950.",
+      "Name cannot be empty.",
+      "Age must be between 1 and 120.",
+      "Record has missing or non-numeric fields."
+    };
+
+    static constexpr std::string_view GetErrorMessage(ValidationError error) noexcept {
+      const auto index = static_cast<std::size_t>(error);
+      return index < std::size(kErrorMessages) ? kErrorMessages[index] : kErrorMessages[0];
+    }
+
+  private:
+    template<typename RuleSet>
+    static ValidationBitmap ValidateAddressColumns(std::size_t rows, const std::uint32_t* street_lengths,
+                                                   const std::uint32_t* city_lengths, const PostalCode* postal_codes);
+};
+
+static_assert(Validator::GetErrorMessage(ValidationError::MalformedRecord) == "Record has missing or non-numeric fields.",
+              "'kErrorMessages' must follow the order of 'ValidationError'.");
+
+void ValidationLog::Drain() {
+  ValidationLogRecord record;
+
+  // Keep going after 'm_running' is cleared until the ring is empty, so no record is lost at exit.
+  for (;;) {
+    if (TryPop(record)) {
+      Print(record);
+      continue;
+    }
+    if (!m_running.load(std::memory_order_acquire)) break;
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  if (const std::size_t dropped{DroppedRecords()}) {
+    std::cerr << "[Validation Failure] " << dropped << " record(s) dropped: log ring was full.\n";
+  }
+}
+
+void ValidationLog::Print(const ValidationLogRecord& record) {
+  const auto microseconds = std::chrono::duration_cast<std::chrono::microseconds>(record.timestamp).count();
+
+  std::cerr << "[Validation Failure +" << microseconds << "us] " << Validator::GetErrorMessage(record.error);
+  if (record.context_length) {
+    std::cerr << " | Context: " << std::string_view(record.context, record.context_length)
+              << (record.context_truncated ? "..." : ""); // Add ellipsis to indicate truncation
+  }
+  if (record.info_length) {
+    std::cerr << " | Info: " << std::string_view(record.info, record.info_length)
+              << (record.info_truncated ? "..." : "");
+  }
+  std::cerr << '\n';
+}
+
+struct ErrorReport {
+  ValidationError error;
+  std::string_view context;
+  std::string_view message;
+
+  void Log() const {
+    Validator::HandleValidationFailure(error, context, message);
+  }
 };
 
 static void ProgramTermination(std::error_code error_code = std::error_code()) {
@@ -156,6 +471,28 @@ static void ProgramTermination(std::error_code error_code = std::error_code()) {
   std::exit(error_code ? error_code.value() : EXIT_SUCCESS);
 }
 
+// Bump allocator for one ingest batch ('std::pmr' monotonic resource). Every string of the
+// Address/Person objects built through it lands in the same region, and 'Release' frees them all
+// in O(1) instead of one 'delete' per string. Objects built with the arena must not outlive it
+// (or the next 'Release'); copy them out with the default resource if they need to.
+class BatchArena {
+  public:
+    explicit BatchArena(std::size_t initial_bytes = 64 * 1024)
+        : m_buffer(initial_bytes), m_resource(m_buffer.data(), m_buffer.size()) {}
+
+    BatchArena(const BatchArena&) = delete;
+    BatchArena& operator=(const BatchArena&) = delete;
+
+    std::pmr::memory_resource* Resource() noexcept { return &m_resource; }
+
+    // Drops every allocation at once and rewinds to the initial buffer for the next batch.
+    void Release() noexcept { m_resource.release(); }
+
+  private:
+    std::vector<std::byte> m_buffer; // First block, reused across batches
+    std::pmr::monotonic_buffer_resource m_resource; // Grows with upstream blocks when the buffer is full
+};
+
 template<typename T, typename... Args>
 // Use 'std::string_view' to prevent multiple copies of error messages.
 auto CreateSafely(std::string_view context, Args&&... args)
@@ -184,6 +521,14 @@ auto CreateSafely(std::string_view context, Args&&... args)
   return result;
 }
 
+// Arena overload: the arena's resource is appended as the trailing argument of 'T::Create'.
+template<typename T, typename... Args>
+auto CreateSafely(BatchArena& arena, std::string_view context, Args&&... args)
+    -> decltype(T::Create(std::forward<Args>(args)..., arena.Resource()))
+{
+  return CreateSafely<T>(context, std::forward<Args>(args)..., arena.Resource());
+}
+
 template<typename T, typename... Args>
 T CreateAndCheck(const std::string& context, Args&&... args) {
   auto result = CreateSafely<T>(context, std::forward<Args>(args)...);
@@ -195,71 +540,253 @@ T CreateAndCheck(const std::string& context, Args&&... args) {
     ProgramTermination(std::make_error_code(std::errc::invalid_argument));
   }
   
-  T created_object = std::get<T>(result);
+  T created_object = std::get<T>(std::move(result)); // Move, so arena-backed strings stay in the arena
   if constexpr (Config::DEBUG_MODE) {
     std::cout << "Successfully created object '" << created_object << "' of type '" << CleanTypeName<T>() << "'.\n";
   }
   return created_object; // Return the valid object
 }
 
+template<typename T, typename... Args>
+T CreateAndCheck(BatchArena& arena, const std::string& context, Args&&... args) {
+  return CreateAndCheck<T>(context, std::forward<Args>(args)..., arena.Resource());
+}
+
+// Column-shaped outcome of 'CreateBatch': index 'i' of both vectors describes argument tuple 'i'.
+template<typename T>
+struct BatchResult {
+  std::vector<std::optional<T>> objects; // Engaged where creation succeeded
+  std::vector<ValidationError> errors;   // 'ValidationError::None' where creation succeeded
+  std::size_t failures{0};
+
+  bool Succeeded(std::size_t index) const noexcept { return errors[index] == ValidationError::None; }
+};
+
+// Bulk counterpart of 'CreateSafely'/'CreateAndCheck': runs 'T::Create' over every argument tuple in
+// 'argument_tuples' (any random-access range of 'std::tuple's), split into contiguous slices across
+// the persistent 'reduce::WorkerPool'. Bad rows never terminate the program; failures are tallied per
+// error kind and reported once per kind on 'std::cerr' after the whole batch has run (whatever
+// 'Config::DEBUG_MODE' is: a handful of summary lines per batch, unlike the per-row validation log).
+// Do not put a 'BatchArena' resource in the tuples: arenas are not thread-safe ('AddressPool' is).
+template<typename T, typename Range>
+BatchResult<T> CreateBatch(std::string_view context, const Range& argument_tuples) {
+  const std::size_t count{static_cast<std::size_t>(std::size(argument_tuples))};
+  const auto first = std::begin(argument_tuples);
+
+  BatchResult<T> batch;
+  batch.objects.resize(count);
+  batch.errors.assign(count, ValidationError::None);
+
+  // Each worker writes only its own slice, so the output columns need no synchronization.
+  reduce::ForEachSlice(count, Config::BATCH_MIN_ROWS_PER_WORKER, [&](std::size_t, std::size_t begin, std::size_t end) {
+    for (std::size_t i{begin}; i < end; ++i) {
+      auto result = std::apply([](const auto&... args) { return T::Create(args...); }, *(first + i));
+
+      if (auto* error = std::get_if<ValidationError>(&result)) {
+        batch.errors[i] = *error;
+      } else {
+        batch.objects[i].emplace(std::get<T>(std::move(result)));
+      }
+    }
+  });
+
+  // Aggregate after the join: one report per error kind instead of one per bad row.
+  std::array<std::size_t, std::size(Validator::kErrorMessages)> counts{};
+  for (ValidationError error : batch.errors) {
+    if (error != ValidationError::None) ++counts[static_cast<std::size_t>(error)];
+  }
+
+  for (std::size_t kind{1}; kind < counts.size(); ++kind) {
+    if (counts[kind] == 0) continue;
+    batch.failures += counts[kind];
+
+    std::cerr << "[Batch Failure] " << counts[kind] << " of " << count << " rows: "
+              << Validator::GetErrorMessage(static_cast<ValidationError>(kind));
+    if (!context.empty()) std::cerr << " | Context: " << context;
+    std::cerr << '\n';
+  }
+
+  return batch;
+}
+
 class Address {
   public:
     static constexpr PostalCode POSTAL_CODE_UNSET{0};
 
   // Factory Method to return either Address or ValidationError - involves pre-creation checks and logic.
-    static std::variant<Address, ValidationError> Create(std::string_view street, std::string_view city, PostalCode postal_code) {
+    // 'resource': where the strings are allocated (e.g.: a 'BatchArena'); the heap by default.
+    static std::variant<Address, ValidationError> Create(std::string_view street, std::string_view city, PostalCode postal_code,
+                                                         std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
       if (auto error = Validator::ValidateAddress(street, city, postal_code)) {
         return *error;
       }
 
-      return Address(std::string(street), std::string(city), postal_code); // Return valid Address if success
+      // Return valid Address if success
+      return Address(std::pmr::string(street, resource), std::pmr::string(city, resource), postal_code);
     }
 
+    // Allocator-extended copy: a plain copy would put the strings back on the default resource.
+    Address(const Address& other, std::pmr::memory_resource* resource)
+        : m_street(other.m_street, resource), m_city(other.m_city, resource), m_postal_code(other.m_postal_code) {}
+
+    Address(const Address&) = default;
+    Address(Address&&) noexcept = default;
+    Address& operator=(const Address&) = default;
+    Address& operator=(Address&&) = default;
+
   // Getters
-    constexpr const std::string& GetStreet() const noexcept { return m_street; }
-    constexpr const std::string& GetCity() const noexcept { return m_city; }
+    constexpr const std::pmr::string& GetStreet() const noexcept { return m_street; }
+    constexpr const std::pmr::string& GetCity() const noexcept { return m_city; }
     constexpr const PostalCode GetPostalCode() const noexcept { return m_postal_code.value_or(POSTAL_CODE_UNSET); }
     // 'value_or': Returns the value if present; otherwise, it provides a default.
 
   // Information Display
     void PrintAddress() const {
-      std::cout << "Street: " << m_street << ", City: " << m_city << ", Postal Code: "
-          << (m_postal_code ? std::to_string(m_postal_code.value()) : "Unset") << '\n';
+      std::cout << "Street: " << m_street << ", City: " << m_city << ", Postal Code: ";
+      WritePostalCode(std::cout);
+      std::cout << '\n';
+    }
+
+    // Bulk output: the 'PrintAddress' line, or one CSV/binary record 'street, city, postal_code'
+    // ('POSTAL_CODE_UNSET' when unset).
+    friend void WriteRecord(output::Writer& out, const Address& address) {
+      if (out.GetFormat() == output::Format::Text) {
+        out << "Street: " << address.m_street << ", City: " << address.m_city << ", Postal Code: ";
+        if (address.m_postal_code) out << *address.m_postal_code;
+        else out << "Unset";
+        out << '\n';
+      } else {
+        out.Record(address.m_street, address.m_city, address.GetPostalCode());
+      }
     }
 
   // Overloaded Operator <<
     friend std::ostream& operator<<(std::ostream& os, const Address& address) {
-      return os << address.m_street << ", " << address.m_city << " ("
-          << (address.m_postal_code ? std::to_string(address.m_postal_code.value()) : "Unset") << ')';
+      os << address.m_street << ", " << address.m_city << " (";
+      address.WritePostalCode(os);
+      return os << ')';
     }
   
   private:
+    // The digits go through 'std::to_chars' into a stack buffer: streamed as an integer, the postal code
+    // would take the digit grouping of the imbued locale ("12.345"), and 'std::to_string' allocates.
+    void WritePostalCode(std::ostream& os) const {
+      if (!m_postal_code) {
+        os << "Unset";
+        return;
+      }
+      char digits[std::numeric_limits<PostalCode>::digits10 + 1];
+      const char* end{std::to_chars(digits, digits + sizeof(digits), *m_postal_code).ptr};
+      os.write(digits, static_cast<std::streamsize>(end - digits));
+    }
+
     // Hide constructor, use Create for control
-    Address(std::string street, std::string city, std::optional<PostalCode> postal_code)
+    Address(std::pmr::string street, std::pmr::string city, std::optional<PostalCode> postal_code)
         // 'std::string_view': Lightweight and non-owning.
         // 'std::move': When transferring ownership of a resource (e.g.: std::string) between scopes.
+        // Moving a 'std::pmr::string' keeps its memory resource, so arena strings stay in the arena.
         : m_street(std::move(street)), m_city(std::move(city)), m_postal_code(postal_code) { // Explicit conversion to'std::string'.
           if constexpr (Config::DEBUG_MODE) {
             std::cout << "Address object created: " << *this << '\n';
           }
     }
 
-    std::string m_street;
-    std::string m_city;
+    std::pmr::string m_street;
+    std::pmr::string m_city;
     std::optional<PostalCode> m_postal_code; // Optional type for unset state
 };
 
+// Interned address storage: each distinct (street, city, postal code) is stored once and every
+// 'Person' living there points at that single copy, so two people share an address exactly when
+// their handles are equal. Entries are never removed, so handles stay valid for the pool's lifetime.
+class AddressPool {
+  public:
+    using Handle = const Address*; // 'std::deque' never relocates its elements on 'push_back'
+
+    explicit AddressPool(std::pmr::memory_resource* resource = std::pmr::get_default_resource())
+        : m_resource(resource) {}
+
+    AddressPool(const AddressPool&) = delete;
+    AddressPool& operator=(const AddressPool&) = delete;
+
+    // Process-wide pool used by 'Person::Create' when no pool is given.
+    static AddressPool& Shared() {
+      static AddressPool pool;
+      return pool;
+    }
+
+    // Returns the handle of an equal address, storing a copy of it on first sight.
+    Handle Intern(const Address& address) {
+      const Key key{address.GetStreet(), address.GetCity(), address.GetPostalCode()};
+      std::lock_guard<std::mutex> lock(m_mutex);
+
+      if (auto it = m_index.find(key); it != m_index.end()) {
+        return it->second;
+      }
+
+      // The key must view the pool's own copy, since the caller's strings may go away.
+      const Address& stored = m_addresses.emplace_back(address, m_resource);
+      m_index.emplace(Key{stored.GetStreet(), stored.GetCity(), stored.GetPostalCode()}, &stored);
+      return &stored;
+    }
+
+    std::size_t Size() const {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      return m_addresses.size();
+    }
+
+  private:
+    struct Key {
+      std::string_view street;
+      std::string_view city;
+      PostalCode postal_code;
+
+      bool operator==(const Key& other) const noexcept {
+        return postal_code == other.postal_code && street == other.street && city == other.city;
+      }
+    };
+
+    struct KeyHash {
+      std::size_t operator()(const Key& key) const noexcept {
+        // 'boost::hash_combine' style mixing.
+        std::size_t seed{std::hash<std::string_view>{}(key.street)};
+        seed ^= std::hash<std::string_view>{}(key.city) + 0x9e37'79b9 + (seed << 6) + (seed >> 2);
+        seed ^= std::hash<PostalCode>{}(key.postal_code) + 0x9e37'79b9 + (seed << 6) + (seed >> 2);
+        return seed;
+      }
+    };
+
+    std::pmr::memory_resource* m_resource;
+    std::deque<Address> m_addresses;
+    std::unordered_map<Key, Handle, KeyHash> m_index;
+    mutable std::mutex m_mutex;
+};
+
 class Person {
   public:
     // Factory Method
-    static std::variant<Person, ValidationError> Create(std::string_view name, const Age age, const Address& address) {
+    // 'resource': where the name is allocated; the address itself is interned in 'pool'.
+    static std::variant<Person, ValidationError> Create(std::string_view name, const Age age, const Address& address,
+                                                        AddressPool& pool,
+                                                        std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
       if (auto error = Validator::ValidatePerson(name, age)) {
         return *error;
       }
 
-      return Person(std::string(name), age, address); // Valid person
+      return Person(std::pmr::string(name, resource), age, pool.Intern(address)); // Valid person
     }
 
+    static std::variant<Person, ValidationError> Create(std::string_view name, const Age age, const Address& address,
+                                                        std::pmr::memory_resource* resource = std::pmr::get_default_resource()) {
+      return Create(name, age, address, AddressPool::Shared(), resource);
+    }
+
+  // Getters
+    const Address& GetAddress() const noexcept { return *m_address; }
+
+    // Interned addresses compare by handle, not by their strings.
+    bool SharesAddressWith(const Person& other) const noexcept { return m_address == other.m_address; }
+
   // Overloaded Operator Function
     friend std::ostream& operator<<(std::ostream& os, const Person& person) {
       return os << person.m_name << ' ' << static_cast<unsigned int>(person.m_age);
@@ -268,25 +795,638 @@ class Person {
   // Information Display
     void PrintPerson() const {
       std::cout << "Name: " << m_name << ", Age: " << static_cast<unsigned int>(m_age) << ", ";
-      m_address.PrintAddress();
+      m_address->PrintAddress();
+    }
+
+    // Bulk output: the 'PrintPerson' line, or one CSV/binary record 'name, age, street, city, postal_code'.
+    friend void WriteRecord(output::Writer& out, const Person& person) {
+      const Address& address{*person.m_address};
+      if (out.GetFormat() == output::Format::Text) {
+        out << "Name: " << person.m_name << ", Age: " << person.m_age << ", ";
+        WriteRecord(out, address);
+      } else {
+        out.Record(person.m_name, person.m_age, address.GetStreet(), address.GetCity(), address.GetPostalCode());
+      }
     }
 
   private:
-    Person(std::string name, Age age, Address address)
+    Person(std::pmr::string name, Age age, AddressPool::Handle address)
         : m_name(std::move(name)), // Explicit conversion to 'std::string'.
           m_age(age),
-          m_address(std::move(address)) // Move the Address to avoid copying.
+          m_address(address) // Handle into the pool instead of a copy.
       {
           if constexpr (Config::DEBUG_MODE) {
             std::cout << "Person object created: " << *this << '\n';
           }
     }
 
-    std::string m_name;
+    std::pmr::string m_name;
     std::uint8_t m_age;
-    Address m_address;
+    AddressPool::Handle m_address;
+};
+
+// Columnar (SoA) store for bulk ingest: street and city live as offset + length into one
+// contiguous character buffer and postal codes as a packed 'PostalCode' column, so validating
+// millions of rows scans a few flat arrays instead of chasing two heap strings per 'Address'.
+// Offsets are 32-bit, so a single table holds up to 4 GiB of street/city text; 'Append' refuses rows past that.
+class AddressTable {
+  public:
+    using Offset = std::uint32_t;
+    static constexpr std::uint32_t kSnapshotKind{snapshot::Kind("ADDR")};
+
+    void Reserve(std::size_t rows, std::size_t characters = 0) {
+      m_street_offsets.reserve(rows);
+      m_street_lengths.reserve(rows);
+      m_city_offsets.reserve(rows);
+      m_city_lengths.reserve(rows);
+      m_postal_codes.reserve(rows);
+      m_characters.reserve(characters);
+    }
+
+    // Rows are appended unvalidated; run 'Validator::ValidateAddressTable' over the whole table instead.
+    // The new row's index, or 'std::nullopt' (and no change) if its text would end past what 'Offset' reaches.
+    std::optional<std::size_t> Append(std::string_view street, std::string_view city, PostalCode postal_code) {
+      constexpr std::size_t kMaxCharacters{std::numeric_limits<Offset>::max()};
+      if (street.size() > kMaxCharacters - m_characters.size()
+          || city.size() > kMaxCharacters - m_characters.size() - street.size()) {
+        return std::nullopt;
+      }
+
+      m_street_offsets.push_back(static_cast<Offset>(m_characters.size()));
+      m_street_lengths.push_back(static_cast<Offset>(street.size()));
+      m_characters.append(street);
+
+      m_city_offsets.push_back(static_cast<Offset>(m_characters.size()));
+      m_city_lengths.push_back(static_cast<Offset>(city.size()));
+      m_characters.append(city);
+
+      m_postal_codes.push_back(postal_code);
+      return m_postal_codes.size() - 1;
+    }
+
+    std::optional<std::size_t> Append(const Address& address);
+
+  // Getters
+    std::size_t Size() const noexcept { return m_postal_codes.size(); }
+    bool Empty() const noexcept { return m_postal_codes.empty(); }
+
+    // Views stay valid until the next 'Append' (which may reallocate the character buffer).
+    std::string_view GetStreet(std::size_t row) const noexcept {
+      return std::string_view(m_characters).substr(m_street_offsets[row], m_street_lengths[row]);
+    }
+    std::string_view GetCity(std::size_t row) const noexcept {
+      return std::string_view(m_characters).substr(m_city_offsets[row], m_city_lengths[row]);
+    }
+    PostalCode GetPostalCode(std::size_t row) const noexcept { return m_postal_codes[row]; }
+
+  // Raw columns for the batch kernels
+    const std::vector<Offset>& StreetLengths() const noexcept { return m_street_lengths; }
+    const std::vector<Offset>& CityLengths() const noexcept { return m_city_lengths; }
+    const std::vector<PostalCode>& PostalCodes() const noexcept { return m_postal_codes; }
+
+    // The character buffer and the five columns as is, for 'AddressTableView'.
+    std::error_code SaveSnapshot(const std::string& path) const {
+      return snapshot::Write(path, kSnapshotKind, Size(), {snapshot::ColumnOf(m_characters),
+                             snapshot::ColumnOf(m_street_offsets), snapshot::ColumnOf(m_street_lengths),
+                             snapshot::ColumnOf(m_city_offsets), snapshot::ColumnOf(m_city_lengths), snapshot::ColumnOf(m_postal_codes)});
+    }
+
+  private:
+    std::string m_characters;
+    std::vector<Offset> m_street_offsets;
+    std::vector<Offset> m_street_lengths;
+    std::vector<Offset> m_city_offsets;
+    std::vector<Offset> m_city_lengths;
+    std::vector<PostalCode> m_postal_codes;
+};
+
+std::optional<std::size_t> AddressTable::Append(const Address& address) {
+  return Append(address.GetStreet(), address.GetCity(), address.GetPostalCode());
+}
+
+// Read-only 'AddressTable' served from a snapshot file ('AddressTable::SaveSnapshot'). Streets and
+// cities are 'std::string_view's straight into the mapping, ready for 'Address::Create' when an object
+// is needed, so reopening millions of addresses costs a header check and one pass over the offsets instead
+// of a parse of every row.
+class AddressTableView {
+  public:
+    using Offset = AddressTable::Offset;
+
+    static std::variant<AddressTableView, std::error_code> Open(const std::string& path) {
+      auto opened = snapshot::MappedSnapshot::Open(path, AddressTable::kSnapshotKind);
+      if (auto* error = std::get_if<std::error_code>(&opened)) return *error;
+
+      AddressTableView view{std::move(std::get<snapshot::MappedSnapshot>(opened))};
+      const snapshot::MappedSnapshot& mapped{view.m_snapshot};
+      const std::size_t rows{mapped.Rows()};
+      const char* characters{mapped.Column<char>(0, mapped.Elements(0))};
+      view.m_street_offsets = mapped.Column<Offset>(1, rows);
+      view.m_street_lengths = mapped.Column<Offset>(2, rows);
+      view.m_city_offsets = mapped.Column<Offset>(3, rows);
+      view.m_city_lengths = mapped.Column<Offset>(4, rows);
+      view.m_postal_codes = mapped.Column<PostalCode>(5, rows);
+      if (!characters || !view.m_street_offsets || !view.m_street_lengths || !view.m_city_offsets || !view.m_city_lengths ||
+          !view.m_postal_codes) {
+        return snapshot::make_error_code(snapshot::Error::BadColumn);
+      }
+      view.m_characters = std::string_view(characters, mapped.Elements(0));
+
+      // One pass over the offsets here, so the getters can slice the buffer without a check per call.
+      const std::uint64_t size{view.m_characters.size()};
+      for (std::size_t row{0}; row < rows; ++row) {
+        if (std::uint64_t{view.m_street_offsets[row]} + view.m_street_lengths[row] > size
+            || std::uint64_t{view.m_city_offsets[row]} + view.m_city_lengths[row] > size) {
+          return snapshot::make_error_code(snapshot::Error::BadColumn);
+        }
+      }
+      return view;
+    }
+
+  // Getters
+    std::size_t Size() const noexcept { return m_snapshot.Rows(); }
+    bool Empty() const noexcept { return Size() == 0; }
+
+    // Unchecked: 'Open' has already checked that every street and city lies inside the character buffer.
+    std::string_view GetStreet(std::size_t row) const noexcept {
+      return std::string_view(m_characters.data() + m_street_offsets[row], m_street_lengths[row]);
+    }
+    std::string_view GetCity(std::size_t row) const noexcept {
+      return std::string_view(m_characters.data() + m_city_offsets[row], m_city_lengths[row]);
+    }
+    PostalCode GetPostalCode(std::size_t row) const noexcept { return m_postal_codes[row]; }
+
+  // Raw columns for the batch kernels
+    const Offset* StreetLengths() const noexcept { return m_street_lengths; }
+    const Offset* CityLengths() const noexcept { return m_city_lengths; }
+    const PostalCode* PostalCodes() const noexcept { return m_postal_codes; }
+
+  private:
+    explicit AddressTableView(snapshot::MappedSnapshot mapped) : m_snapshot(std::move(mapped)) {}
+
+    snapshot::MappedSnapshot m_snapshot;
+    std::string_view m_characters;
+    const Offset* m_street_offsets{nullptr};
+    const Offset* m_street_lengths{nullptr};
+    const Offset* m_city_offsets{nullptr};
+    const Offset* m_city_lengths{nullptr};
+    const PostalCode* m_postal_codes{nullptr};
+};
+
+// Sets bit 'i' of 'out' whenever 'column[i]' falls outside [low, high].
+// Uses the unsigned trick '(value - low) > (high - low)' so each check is a single compare.
+static void MarkOutOfRange(const std::uint32_t* column, std::size_t count, std::uint32_t low, std::uint32_t high,
+                           std::vector<ValidationBitmap::Word>& out) {
+  using Word = ValidationBitmap::Word;
+  const std::uint32_t span{high - low};
+  out.assign(ValidationBitmap::WordsFor(count), 0);
+
+  for (std::size_t word_index{0}; word_index < out.size(); ++word_index) {
+    const std::size_t base{word_index * ValidationBitmap::kBitsPerWord};
+    const std::size_t lanes{std::min(ValidationBitmap::kBitsPerWord, count - base)};
+    const std::uint32_t* values{column + base};
+    Word word{0};
+    std::size_t j{0};
+
+    #if SUPPORTS_AVX2
+      // AVX2 has no unsigned compare; flipping the sign bit maps unsigned order onto signed order.
+      const __m256i bias{_mm256_set1_epi32(static_cast<int>(0x8000'0000U))};
+      const __m256i lower{_mm256_set1_epi32(static_cast<int>(low))};
+      const __m256i limit{_mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(span)), bias)};
+      for (; j + 8 <= lanes; j += 8) {
+        __m256i lane{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + j))};
+        lane = _mm256_xor_si256(_mm256_sub_epi32(lane, lower), bias);
+        const int mask{_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpgt_epi32(lane, limit)))};
+        word |= static_cast<Word>(static_cast<unsigned int>(mask)) << j;
+      }
+    #endif // SUPPORTS_AVX2
+
+    // Branchless scalar tail (and the whole word without AVX2, which compilers auto-vectorize).
+    for (; j < lanes; ++j) {
+      word |= static_cast<Word>(values[j] - low > span) << j;
+    }
+
+    out[word_index] = word;
+  }
+}
+
+#if SUPPORTS_CPP20
+  std::vector<ValidationError> Validator::ValidateBatchAddresses(std::span<const Address> addresses) {
+#else
+  std::vector<ValidationError> Validator::ValidateBatchAddresses(const std::vector<Address>& addresses) {
+#endif // SUPPORTS_CPP20
+  std::vector<ValidationError> errors;
+
+  for (const auto& address : addresses) {
+    if (auto error = ValidateAddress(address.GetStreet(), address.GetCity(), address.GetPostalCode())) {
+      errors.push_back(*error);
+    }
+  }
+
+  return errors;
+}
+
+template<typename RuleSet>
+ValidationBitmap Validator::ValidateAddressTable(const AddressTable& table) {
+  return ValidateAddressColumns<RuleSet>(table.Size(), table.StreetLengths().data(), table.CityLengths().data(),
+                                         table.PostalCodes().data());
+}
+
+template<typename RuleSet>
+ValidationBitmap Validator::ValidateAddressTable(const AddressTableView& table) {
+  return ValidateAddressColumns<RuleSet>(table.Size(), table.StreetLengths(), table.CityLengths(), table.PostalCodes());
+}
+
+template<typename RuleSet>
+ValidationBitmap Validator::ValidateAddressColumns(std::size_t rows, const std::uint32_t* street_lengths,
+                                                   const std::uint32_t* city_lengths, const PostalCode* postal_codes) {
+  static_assert(std::is_same_v<typename RuleSet::StreetRule, NonEmptyRule<ValidationError::EmptyStreet>> &&
+                std::is_same_v<typename RuleSet::CityRule, NonEmptyRule<ValidationError::EmptyCity>>,
+                "The column kernel only implements non-empty street and city rules.");
+  using PostalCodeRule = typename RuleSet::PostalCodeRule;
+
+  ValidationBitmap bitmap;
+  bitmap.rows = rows;
+
+  // An empty field is a length outside [1, max], so all three rules share the same range kernel.
+  constexpr std::uint32_t kMaxLength{std::numeric_limits<AddressTable::Offset>::max()};
+  MarkOutOfRange(street_lengths, bitmap.rows, 1, kMaxLength, bitmap.empty_street);
+  MarkOutOfRange(city_lengths, bitmap.rows, 1, kMaxLength, bitmap.empty_city);
+  MarkOutOfRange(postal_codes, bitmap.rows, PostalCodeRule::kMin, PostalCodeRule::kMax, bitmap.invalid_postal_code);
+
+  return bitmap;
+}
+
+// Read-only memory mapping of a file, one window at a time, so arbitrarily large files can be
+// scanned with a bounded address-space footprint. The OS pages the data in; nothing is copied.
+class MappedFile {
+  public:
+    static std::variant<MappedFile, std::error_code> Open(const std::string& path) {
+      MappedFile file;
+      #ifdef _WIN32
+        file.m_file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                  FILE_FLAG_SEQUENTIAL_SCAN, nullptr);
+        if (file.m_file == INVALID_HANDLE_VALUE) return LastError();
+
+        LARGE_INTEGER size;
+        if (!GetFileSizeEx(file.m_file, &size)) return LastError();
+        file.m_size = static_cast<std::uint64_t>(size.QuadPart);
+
+        if (file.m_size > 0) { // Mapping an empty file fails on Windows
+          file.m_mapping = CreateFileMappingA(file.m_file, nullptr, PAGE_READONLY, 0, 0, nullptr);
+          if (!file.m_mapping) return LastError();
+        }
+
+        SYSTEM_INFO info;
+        GetSystemInfo(&info);
+        file.m_granularity = info.dwAllocationGranularity; // View offsets must be multiples of this
+      #else
+        file.m_descriptor = ::open(path.c_str(), O_RDONLY);
+        if (file.m_descriptor < 0) return LastError();
+
+        struct stat info;
+        if (::fstat(file.m_descriptor, &info) != 0) return LastError();
+        file.m_size = static_cast<std::uint64_t>(info.st_size);
+        file.m_granularity = static_cast<std::uint64_t>(::sysconf(_SC_PAGESIZE));
+      #endif // _WIN32
+      return file;
+    }
+
+    MappedFile(MappedFile&& other) noexcept { Swap(other); }
+    MappedFile& operator=(MappedFile&& other) noexcept { Swap(other); return *this; }
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+
+    ~MappedFile() noexcept {
+      Unmap();
+      #ifdef _WIN32
+        if (m_mapping) CloseHandle(m_mapping);
+        if (m_file != INVALID_HANDLE_VALUE) CloseHandle(m_file);
+      #else
+        if (m_descriptor >= 0) ::close(m_descriptor);
+      #endif // _WIN32
+    }
+
+    std::uint64_t Size() const noexcept { return m_size; }
+    std::uint64_t Granularity() const noexcept { return m_granularity; }
+
+    // Replaces the current window with [offset, offset + length); 'offset' must be a multiple of 'Granularity'.
+    std::variant<std::string_view, std::error_code> Map(std::uint64_t offset, std::size_t length) {
+      Unmap();
+      if (length == 0) return std::string_view{};
+
+      #ifdef _WIN32
+        m_view = MapViewOfFile(m_mapping, FILE_MAP_READ, static_cast<DWORD>(offset >> 32),
+                               static_cast<DWORD>(offset & 0xFFFF'FFFF), length);
+        if (!m_view) return LastError();
+      #else
+        void* view{::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, m_descriptor, static_cast<off_t>(offset))};
+        if (view == MAP_FAILED) return LastError();
+        ::madvise(view, length, MADV_SEQUENTIAL); // Read-ahead hint; failure is harmless
+        m_view = view;
+      #endif // _WIN32
+
+      m_view_length = length;
+      return std::string_view(static_cast<const char*>(m_view), length);
+    }
+
+  private:
+    MappedFile() = default;
+
+    static std::error_code LastError() {
+      #ifdef _WIN32
+        return std::error_code(static_cast<int>(GetLastError()), std::system_category());
+      #else
+        return std::error_code(errno, std::system_category());
+      #endif // _WIN32
+    }
+
+    void Unmap() noexcept {
+      if (!m_view) return;
+      #ifdef _WIN32
+        UnmapViewOfFile(m_view);
+      #else
+        ::munmap(m_view, m_view_length);
+      #endif // _WIN32
+      m_view = nullptr;
+      m_view_length = 0;
+    }
+
+    void Swap(MappedFile& other) noexcept {
+      #ifdef _WIN32
+        std::swap(m_file, other.m_file);
+        std::swap(m_mapping, other.m_mapping);
+      #else
+        std::swap(m_descriptor, other.m_descriptor);
+      #endif // _WIN32
+      std::swap(m_size, other.m_size);
+      std::swap(m_granularity, other.m_granularity);
+      std::swap(m_view, other.m_view);
+      std::swap(m_view_length, other.m_view_length);
+    }
+
+    #ifdef _WIN32
+      HANDLE m_file{INVALID_HANDLE_VALUE};
+      HANDLE m_mapping{nullptr};
+    #else
+      int m_descriptor{-1};
+    #endif // _WIN32
+    std::uint64_t m_size{0};
+    std::uint64_t m_granularity{4'096};
+    void* m_view{nullptr};
+    std::size_t m_view_length{0};
 };
 
+// Streaming CSV/TSV reader over a 'MappedFile'. Each record is handed to the callback as
+// 'std::string_view' fields pointing straight into the mapping, so they can go directly into
+// 'Address::Create'/'Person::Create' without building a 'std::string' per field. The file is walked
+// in 'Config::INGEST_WINDOW_BYTES' windows, so memory use stays constant whatever the file size.
+//
+// Fields may be wrapped in double quotes to contain the delimiter; the quotes are stripped, but
+// doubled quotes inside are left as-is (unescaping would need a copy). '\r\n' endings are accepted.
+class DelimitedReader {
+  public:
+    static std::variant<DelimitedReader, std::error_code> Open(const std::string& path, char delimiter = ',') {
+      auto file = MappedFile::Open(path);
+      if (auto* error = std::get_if<std::error_code>(&file)) return *error;
+      return DelimitedReader(std::get<MappedFile>(std::move(file)), delimiter);
+    }
+
+    // 'on_record(line_number, fields)': the views are only valid during the call. Blank lines are skipped.
+    // Fails with 'std::errc::value_too_large' if a single record does not fit in one window.
+    template<typename Callback>
+    std::error_code ForEachRecord(Callback&& on_record) {
+      const std::uint64_t size{m_file.Size()};
+      const std::uint64_t granularity{m_file.Granularity()};
+      const std::uint64_t window{std::max<std::uint64_t>(Config::INGEST_WINDOW_BYTES / granularity, 2) * granularity};
+      std::uint64_t offset{0}; // First byte not yet consumed
+      std::size_t line_number{0};
+
+      while (offset < size) {
+        const std::uint64_t aligned{offset - offset % granularity};
+        const auto length = static_cast<std::size_t>(std::min(window, size - aligned));
+        const bool last_window{aligned + length == size};
+
+        auto mapped = m_file.Map(aligned, length);
+        if (auto* error = std::get_if<std::error_code>(&mapped)) return *error;
+        std::string_view data{std::get<std::string_view>(mapped).substr(static_cast<std::size_t>(offset - aligned))};
+
+        std::size_t consumed{0};
+        for (;;) {
+          const std::size_t newline{data.find('\n', consumed)};
+          if (newline == std::string_view::npos && !(last_window && consumed < data.size())) break;
+
+          const std::size_t line_end{newline == std::string_view::npos ? data.size() : newline};
+          std::string_view line{data.substr(consumed, line_end - consumed)};
+          consumed = newline == std::string_view::npos ? data.size() : newline + 1;
+          ++line_number;
+
+          if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+          if (line.empty()) continue;
+
+          SplitFields(line);
+          on_record(line_number, static_cast<const std::vector<std::string_view>&>(m_fields));
+        }
+
+        if (consumed == 0 && !last_window) return std::make_error_code(std::errc::value_too_large);
+        offset += consumed; // A partial trailing record is re-read at the start of the next window
+      }
+
+      return {};
+    }
+
+  private:
+    DelimitedReader(MappedFile file, char delimiter) : m_file(std::move(file)), m_delimiter(delimiter) {}
+
+    void SplitFields(std::string_view line) {
+      m_fields.clear(); // Keeps its capacity, so steady-state records allocate nothing
+
+      std::size_t position{0};
+      for (;;) {
+        if (position < line.size() && line[position] == '"') {
+          const std::size_t closing{FindClosingQuote(line, position + 1)};
+          m_fields.push_back(line.substr(position + 1, closing - position - 1));
+          position = std::min(line.size(), closing + 1);
+          position = line.find(m_delimiter, position); // Anything between the quote and the delimiter is dropped
+        } else {
+          const std::size_t next{line.find(m_delimiter, position)};
+          m_fields.push_back(line.substr(position, next == std::string_view::npos ? std::string_view::npos : next - position));
+          position = next;
+        }
+
+        if (position == std::string_view::npos) break;
+        ++position; // Skip the delimiter
+      }
+    }
+
+    // Position of the quote ending a field, skipping '""' pairs; 'line.size()' if it is unterminated.
+    static std::size_t FindClosingQuote(std::string_view line, std::size_t position) {
+      for (;;) {
+        position = line.find('"', position);
+        if (position == std::string_view::npos) return line.size();
+        if (position + 1 < line.size() && line[position + 1] == '"') {
+          position += 2;
+          continue;
+        }
+        return position;
+      }
+    }
+
+    MappedFile m_file;
+    char m_delimiter;
+    std::vector<std::string_view> m_fields;
+};
+
+// 'std::from_chars' based parsing for numeric fields: no locale, no allocation, rejects trailing junk.
+template<typename Number>
+std::optional<Number> ParseField(std::string_view field) {
+  Number value{};
+  const char* end{field.data() + field.size()};
+  auto [pointer, error] = std::from_chars(field.data(), end, value);
+  if (error != std::errc() || pointer != end) return std::nullopt;
+  return value;
+}
+
+// Expected columns: name, age, street, city, postal code.
+struct IngestSummary {
+  std::size_t records{0};
+  std::size_t people{0};
+  std::size_t malformed{0};
+  std::size_t invalid{0};
+};
+
+// Rows of a people file gathered for one 'CreateBatch' call. The reader's views die with each record,
+// so the strings are copied; the columns only grow, and their strings keep their capacity between batches.
+struct IngestRows {
+  std::size_t size{0};
+  std::vector<std::string> names, streets, cities;
+  std::vector<Age> ages;
+  std::vector<PostalCode> postal_codes;
+
+  void Add(std::string_view name, Age age, std::string_view street, std::string_view city, PostalCode postal_code) {
+    if (size == names.size()) {
+      names.emplace_back();
+      streets.emplace_back();
+      cities.emplace_back();
+      ages.emplace_back();
+      postal_codes.emplace_back();
+    }
+    names[size].assign(name);
+    streets[size].assign(street);
+    cities[size].assign(city);
+    ages[size] = age;
+    postal_codes[size] = postal_code;
+    ++size;
+  }
+};
+
+// Creates the addresses of 'rows' with 'CreateBatch', then the persons whose address was valid (interned
+// in 'pool', which is thread-safe), and clears 'rows'. Failures are reported once per kind by 'CreateBatch'.
+static void IngestBatch(std::string_view context, IngestRows& rows, AddressPool& pool, IngestSummary& summary) {
+  std::vector<std::tuple<std::string_view, std::string_view, PostalCode>> address_arguments;
+  address_arguments.reserve(rows.size);
+  for (std::size_t i{0}; i < rows.size; ++i) {
+    address_arguments.emplace_back(rows.streets[i], rows.cities[i], rows.postal_codes[i]);
+  }
+  const BatchResult<Address> addresses{CreateBatch<Address>(context, address_arguments)};
+
+  using PersonArguments = std::tuple<std::string_view, Age, std::reference_wrapper<const Address>, std::reference_wrapper<AddressPool>>;
+  std::vector<PersonArguments> person_arguments;
+  person_arguments.reserve(rows.size - addresses.failures);
+  for (std::size_t i{0}; i < rows.size; ++i) {
+    if (addresses.Succeeded(i)) person_arguments.emplace_back(rows.names[i], rows.ages[i], *addresses.objects[i], pool);
+  }
+  const BatchResult<Person> people{CreateBatch<Person>(context, person_arguments)};
+
+  summary.people += person_arguments.size() - people.failures;
+  summary.invalid += addresses.failures + people.failures;
+  rows.size = 0;
+}
+
+// Streams a people file through the factories, 'Config::INGEST_BATCH_ROWS' rows per 'CreateBatch' call,
+// so memory use stays bounded and only the distinct addresses (in 'pool') accumulate.
+static std::variant<IngestSummary, std::error_code> IngestPeople(const std::string& path, AddressPool& pool, char delimiter = ',') {
+  auto opened = DelimitedReader::Open(path, delimiter);
+  if (auto* error = std::get_if<std::error_code>(&opened)) return *error;
+  DelimitedReader& reader{std::get<DelimitedReader>(opened)};
+
+  IngestSummary summary;
+  IngestRows rows;
+
+  const std::error_code error = reader.ForEachRecord([&](std::size_t line_number, const std::vector<std::string_view>& fields) {
+    ++summary.records;
+    const auto age = fields.size() == 5 ? ParseField<unsigned int>(fields[1]) : std::nullopt;
+    const auto postal_code = fields.size() == 5 ? ParseField<PostalCode>(fields[4]) : std::nullopt;
+    if (!age || !postal_code) {
+      ++summary.malformed;
+      Validator::HandleValidationFailure(ValidationError::MalformedRecord, path, line_number);
+      return;
+    }
+
+    // Ages above 'Age' range become 0, which 'ValidatePerson' rejects.
+    const Age clamped_age{static_cast<Age>(*age <= std::numeric_limits<Age>::max() ? *age : 0)};
+    rows.Add(fields[0], clamped_age, fields[2], fields[3], *postal_code);
+    if (rows.size == Config::INGEST_BATCH_ROWS) IngestBatch(path, rows, pool, summary);
+  });
+
+  if (error) return error;
+  if (rows.size) IngestBatch(path, rows, pool, summary);
+  return summary;
+}
+
+// Usage: run.exe --save-snapshot <snapshot> <people.csv> - streams the file like the ingest mode, keeps each
+// row's street, city and postal code (unvalidated, as 'AddressTable' takes them) and saves the table for
+// '--load-snapshot'.
+static int RunSaveSnapshotMode(const char* snapshot_path, const char* path) {
+  auto opened = DelimitedReader::Open(path);
+  if (auto* error = std::get_if<std::error_code>(&opened)) {
+    std::cerr << "Error: Cannot read '" << path << "': " << error->message() << '\n';
+    return EXIT_FAILURE;
+  }
+
+  DelimitedReader& reader{std::get<DelimitedReader>(opened)};
+
+  AddressTable table;
+  std::size_t malformed{0};
+  bool too_large{false}; // Past the 4 GiB of text 'AddressTable' offsets reach
+
+  const std::error_code error = reader.ForEachRecord([&](std::size_t line_number, const std::vector<std::string_view>& fields) {
+    const auto postal_code = fields.size() == 5 ? ParseField<PostalCode>(fields[4]) : std::nullopt;
+    if (!postal_code) {
+      ++malformed;
+      Validator::HandleValidationFailure(ValidationError::MalformedRecord, path, line_number);
+      return;
+    }
+    too_large = too_large || !table.Append(fields[2], fields[3], *postal_code);
+  });
+
+  if (error || too_large) {
+    const std::error_code reason{error ? error : std::make_error_code(std::errc::value_too_large)};
+    std::cerr << "Error: Cannot read '" << path << "': " << reason.message() << '\n';
+    return EXIT_FAILURE;
+  }
+  if (const std::error_code write_error{table.SaveSnapshot(snapshot_path)}) {
+    std::cerr << "Error: Cannot write '" << snapshot_path << "': " << write_error.message() << '\n';
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Saved " << table.Size() << " addresses to '" << snapshot_path << "' (malformed: " << malformed << ")\n";
+  return malformed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// Usage: run.exe --load-snapshot <snapshot> - maps a saved table and validates it column by column.
+static int RunLoadSnapshotMode(const char* snapshot_path) {
+  auto opened = AddressTableView::Open(snapshot_path);
+  if (auto* error = std::get_if<std::error_code>(&opened)) {
+    std::cerr << "Error: Cannot load '" << snapshot_path << "': " << error->message() << '\n';
+    return EXIT_FAILURE;
+  }
+  const AddressTableView& table{std::get<AddressTableView>(opened)};
+
+  std::cout << "Addresses: " << table.Size() << ", Invalid: " << Validator::ValidateAddressTable(table).CountFailures()
+      << " (from snapshot)\n";
+  return EXIT_SUCCESS;
+}
+
 static void SetupConsole() {
   if (!Config::DEVELOPER_MODE) std::system("cls");
   std::system("title \"Address & Person\"");
@@ -300,11 +1440,151 @@ static void LocaleSetup() {
   std::cout.imbue(std::locale());
 }
 
+#if BENCHMARK_ENABLED
+// Usage: run.exe --benchmark [max_addresses] - address/person construction (heap and 'BatchArena') and
+// batch validation ('ValidateBatchAddresses' on objects, 'ValidateAddressTable' and 'CreateBatch' on
+// rows with ~6% bad ones, also on a snapshot of them) over random data, from 1K up to 'max_addresses' (1K, 10K, ...; default 1M).
+static int RunAddressBenchmark(std::size_t max_addresses) {
+  bench::Generator generator;
+  bench::PrintHeader();
+
+  for (std::size_t count : bench::Scales(max_addresses)) {
+    std::vector<std::string> streets(count), cities(count), names(count);
+    std::vector<PostalCode> postal_codes(count);
+    std::vector<Age> ages(count);
+    for (std::size_t i{0}; i < count; ++i) {
+      streets[i] = generator.Word(4, 12) + " Street"; // Mostly past the small-string buffer
+      cities[i] = generator.Word(3, 12);
+      postal_codes[i] = generator.Uniform<PostalCode>(1, 99'950);
+      names[i] = generator.Word(3, 8) + ' ' + generator.Word(4, 10);
+      ages[i] = generator.Uniform<Age>(1, 120);
+    }
+
+    std::vector<Address> addresses;
+    bench::Run("Address::Create", count, [&] { addresses.clear(); }, [&] {
+      addresses.reserve(count);
+      for (std::size_t i{0}; i < count; ++i) {
+        addresses.push_back(std::get<Address>(Address::Create(streets[i], cities[i], postal_codes[i])));
+      }
+    });
+
+    BatchArena arena;
+    bench::Run("Address::Create (BatchArena)", count, [&] { arena.Release(); }, [&] {
+      for (std::size_t i{0}; i < count; ++i) {
+        bench::DoNotOptimize(Address::Create(streets[i], cities[i], postal_codes[i], arena.Resource()));
+      }
+    });
+
+    AddressPool pool;
+    for (const Address& address : addresses) pool.Intern(address); // Interning is measured by the ingest path
+    bench::Run("Person::Create (BatchArena)", count, [&] { arena.Release(); }, [&] {
+      for (std::size_t i{0}; i < count; ++i) {
+        bench::DoNotOptimize(Person::Create(names[i], ages[i], addresses[i], pool, arena.Resource()));
+      }
+    });
+
+    bench::Run("ValidateBatchAddresses", count, [&] { bench::DoNotOptimize(Validator::ValidateBatchAddresses(addresses)); });
+
+    // The table takes unvalidated rows, so it can carry the bad ones the factories refuse.
+    AddressTable table;
+    table.Reserve(count);
+    std::size_t expected_failures{0};
+    for (std::size_t i{0}; i < count; ++i) {
+      const bool empty_street{generator.Chance(0.01)};
+      const PostalCode postal_code{generator.Chance(0.05) ? generator.Uniform<PostalCode>(99'951, 200'000) : postal_codes[i]};
+      table.Append(empty_street ? std::string_view() : std::string_view(streets[i]), cities[i], postal_code);
+      expected_failures += Validator::ValidateAddress(table.GetStreet(i), table.GetCity(i), postal_code).has_value();
+    }
+
+    std::size_t failures{0};
+    bench::Run("ValidateAddressTable", count, [&] { failures = Validator::ValidateAddressTable(table).CountFailures(); });
+    if (failures != expected_failures) {
+      std::cerr << "Error: 'ValidateAddressTable' found " << failures << " bad rows instead of " << expected_failures << ".\n";
+      return EXIT_FAILURE;
+    }
+
+    // The same rows, bad ones included, through the factory on the worker pool as the ingest path runs them.
+    std::vector<std::tuple<std::string_view, std::string_view, PostalCode>> address_arguments;
+    address_arguments.reserve(count);
+    for (std::size_t i{0}; i < count; ++i) address_arguments.emplace_back(table.GetStreet(i), table.GetCity(i), table.GetPostalCode(i));
+
+    std::streambuf* const log{std::cerr.rdbuf(nullptr)}; // One '[Batch Failure]' summary per iteration is noise here
+    std::size_t batch_failures{0};
+    bench::Run("CreateBatch<Address>", count, [&] { batch_failures = CreateBatch<Address>("benchmark", address_arguments).failures; });
+    std::cerr.rdbuf(log);
+    if (batch_failures != expected_failures) {
+      std::cerr << "Error: 'CreateBatch' refused " << batch_failures << " rows instead of " << expected_failures << ".\n";
+      return EXIT_FAILURE;
+    }
+
+    // Restart: the table saved once and mapped back, then validated in place.
+    const std::string path{bench::TemporaryPath("addresses.snapshot")};
+    bench::Run("AddressTable::SaveSnapshot", count, [&] { bench::DoNotOptimize(table.SaveSnapshot(path)); });
+    bench::Run("AddressTableView::Open", count, [&] { bench::DoNotOptimize(AddressTableView::Open(path).index()); });
+
+    auto opened = AddressTableView::Open(path);
+    std::size_t view_failures{0};
+    if (auto* view = std::get_if<AddressTableView>(&opened)) {
+      bench::Run("ValidateAddressTable (view)", count, [&] { view_failures = Validator::ValidateAddressTable(*view).CountFailures(); });
+      if (view->GetStreet(count - 1) != table.GetStreet(count - 1) || view->GetCity(0) != table.GetCity(0)) view_failures = count + 1;
+    }
+    std::error_code ignored;
+    std::filesystem::remove(path, ignored);
+
+    if (view_failures != expected_failures) {
+      std::cerr << "Error: the snapshot of the table does not match it at " << count << " addresses.\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+#endif // BENCHMARK_ENABLED
+
+
+// Usage: run.exe [people.csv] | --save-snapshot <snapshot> <people.csv> | --load-snapshot <snapshot> | --benchmark [max_addresses]
+// With a file argument, streams its 'name,age,street,city,postal_code' rows instead of the demo objects.
+int main(int argc, char* argv[]) {
+  if (argc > 3 && std::string_view(argv[1]) == "--save-snapshot") {
+    return RunSaveSnapshotMode(argv[2], argv[3]);
+  }
+
+  if (argc > 2 && std::string_view(argv[1]) == "--load-snapshot") {
+    return RunLoadSnapshotMode(argv[2]);
+  }
+
+  if (argc > 1 && std::string_view(argv[1]) == "--benchmark") {
+    #if BENCHMARK_ENABLED
+      return RunAddressBenchmark(bench::ParseCount(argc > 2 ? argv[2] : nullptr, 1'000'000));
+    #else
+      std::cerr << "Error: '--benchmark' needs a build with -DENABLE_BENCHMARK.\n";
+      return EXIT_FAILURE;
+    #endif // BENCHMARK_ENABLED
+  }
 
-int main() {
   SetupConsole();
   LocaleSetup();
 
+  if (argc > 1) {
+    AddressPool pool;
+    auto result = IngestPeople(argv[1], pool);
+
+    if (auto* error = std::get_if<std::error_code>(&result)) {
+      std::cerr << "Cannot read '" << argv[1] << "': " << error->message() << '\n';
+      ProgramTermination(*error);
+    }
+
+    const IngestSummary& summary{std::get<IngestSummary>(result)};
+    std::cout << "Records: " << summary.records << ", People: " << summary.people
+        << ", Invalid: " << summary.invalid << ", Malformed: " << summary.malformed
+        << ", Distinct addresses: " << pool.Size() << '\n';
+    ProgramTermination();
+  }
+
+  // Literal inputs are validated by the compiler, so these can never fail at runtime.
+  static_assert(!Validator::ValidateAddress("Valid Street", "Valid City", 12345), "Invalid demo address.");
+  static_assert(!Validator::ValidatePerson("John Doe", 30), "Invalid demo person.");
+
   auto address = CreateAndCheck<Address>("Main", "Valid Street", "Valid City", 12345);
   auto person = CreateAndCheck<Person>("Main", "John Doe", 30, address);
 
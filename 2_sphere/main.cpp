@@ -2,16 +2,57 @@
 // This program models a simple system for validating and calculating the volume of spheres.
 
 #include <iostream>
-#include <stdexcept>
+#include <fstream>
 #include <cstdint>
 #include <cmath>
 #include <vector>
-#include <array>
+#include <algorithm>
 #include <limits>
+#include <cstddef>
+#include <string>
+#include <string_view>
+#include <charconv>
+#include <cstdio>
+#include <cstdlib>
+#include <system_error>
+#include <optional>
+#include <variant>
+#include <filesystem>
+#include <utility>
+#include "../common/trace.h" // Lifecycle events and timings; compiled out unless -DENABLE_TRACING
+#include "../common/bench.h" // '--benchmark' harness and data generators; compiled out unless -DENABLE_BENCHMARK
+#include "../common/output.h" // Buffered text/CSV/binary reports
+#include "../common/input.h" // Whole-stream reads for the bulk input mode
+#include "../common/snapshot.h" // Binary snapshots loaded by memory mapping
+#include "../common/reduce.h" // Reducers and the slicing of the parallel kernels
+
+#if __cplusplus >= 202002L
+  #include <span>
+  #define SUPPORTS_CPP20 1
+#else
+  #define SUPPORTS_CPP20 0
+#endif // __cplusplus
+
+// Compile with '-mavx2' (or '-march=native') for the x86 kernel; AArch64 always has NEON.
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define SUPPORTS_AVX2 1
+#else
+  #define SUPPORTS_AVX2 0
+#endif // __AVX2__
+
+#if defined(__aarch64__) && defined(__ARM_NEON)
+  #include <arm_neon.h>
+  #define SUPPORTS_NEON 1
+#else
+  #define SUPPORTS_NEON 0
+#endif // __aarch64__
 
 namespace Config {
   constexpr bool DEVELOPER_MODE = false;
-  constexpr bool CONFIDENTIAL_OVERRIDE = false;
+
+  // Smallest chunk of a volume column worth handing to its own thread in 'CalculateVolumeStatistics'.
+  constexpr std::size_t STATISTICS_MIN_VOLUMES_PER_WORKER = 1 << 16;
 }
 
 // Because 'std::acos' is not a 'constexpr' function, I can't write: constexpr double PI = std::acos(-1); by including the 'cmath' library.
@@ -19,46 +60,67 @@ namespace Config {
 constexpr double PI = 3.14159265358979323846;
 constexpr std::uint8_t kSpheres = 5;
 
+// Folded once so every volume is a single multiply by 'r * r * r'; shared by the scalar and batch paths.
+constexpr double kVolumeFactor = (4.0 / 3.0) * PI;
+constexpr double kMaxRadius = 1'025'867;
+
+enum class ValidationError {
+  None = 0,
+  InvalidRadius
+};
+
+// Indexed by 'ValidationError'; what 'Sphere::HandleValidationFailure' reports in developer mode.
+constexpr std::string_view kErrorMessages[]{
+  "Unknown validation error.\n",
+  "Error: The radius must be greater than zero and less than a million.\n"
+};
+
 class Sphere {
   public:
   // Constructors and Destructor
     Sphere() : m_radius(10) {
-      if (Config::DEVELOPER_MODE) {
-        std::cout << "Default constructor running for sphere with radius: 10\n";
-      }
+      TRACE_OBJECT_CREATED("Sphere", this);
     }
 
+    // Validates without throwing: a bad radius costs a compare, not a stack unwind.
     explicit Sphere(double radius) : m_radius(radius) {
-      try {
-        ValidateParameter(m_radius);
-        if (Config::DEVELOPER_MODE) {
-          std::cout << "Parameterized constructor (1/1) running for sphere with radius: " << radius << '\n';
-        }
-      } catch (const std::invalid_argument& e) {
-        HandleValidationFailure(e);
+      TRACE_OBJECT_CREATED("Sphere", this);
+
+      if (!IsValidRadius(m_radius)) {
+        HandleValidationFailure(ValidationError::InvalidRadius);
 
         // Take corrective action
         m_radius = 10;
         std::cout << "Fallback radius set to: " << m_radius << '\n';
+        return;
       }
     }
 
-    ~Sphere() noexcept {
-      if (Config::DEVELOPER_MODE && Config::CONFIDENTIAL_OVERRIDE) {
-        std::cout << "Destructor running for sphere with radius: " << m_radius << "\n";
+  // Factory Method - like 1_address's 'Create': either a valid Sphere or the reason it is not, no fallback.
+    static std::variant<Sphere, ValidationError> TryCreate(double radius) {
+      if (!IsValidRadius(radius)) {
+        return ValidationError::InvalidRadius;
       }
+
+      return Sphere(radius);
+    }
+
+    ~Sphere() noexcept {
+      TRACE_OBJECT_DESTROYED("Sphere", this);
     }
 
-  // Setter
+  // Setters
     void SetRadius(double radius) {
-      try {
-        ValidateParameter(radius);
-      } catch (const std::invalid_argument& e) {
-        HandleValidationFailure(e);
-        return;
+      if (auto error = TrySetRadius(radius)) {
+        HandleValidationFailure(*error);
       }
+    }
 
+    // Non-throwing, silent variant: leaves the radius unchanged and returns the error instead.
+    std::optional<ValidationError> TrySetRadius(double radius) noexcept {
+      if (!IsValidRadius(radius)) return ValidationError::InvalidRadius;
       m_radius = radius;
+      return std::nullopt;
     }
 
   // Getter
@@ -68,7 +130,7 @@ class Sphere {
   
   // Class Methods
     double CalculateVolume() const {
-      return (4.0 / 3.0) * PI * std::pow(m_radius, 3);
+      return kVolumeFactor * (m_radius * m_radius * m_radius); // 'std::pow' is a library call per sphere
     }
 
   // Overloaded Operator Function
@@ -77,16 +139,28 @@ class Sphere {
       // I could use a key for differentiating between objects with the same radius - even this is too much for such a small program
     }
 
-  // Helper Functions
-    void ValidateParameter(double radius) {
-      if (radius <= 0 || radius > 1'025'867) {
-        throw std::invalid_argument("Error: The radius must be greater than zero and less than a million.\n");
+  // Bulk output: the 'operator<<' line, or one CSV/binary record 'radius, volume'.
+    friend void WriteRecord(output::Writer& out, const Sphere& sphere) {
+      WriteRecord(out, sphere.m_radius, sphere.CalculateVolume());
+    }
+
+    // Shared with 'SphereSet::WriteRecords', which has the columns but no 'Sphere' objects.
+    static void WriteRecord(output::Writer& out, double radius, double volume) {
+      if (out.GetFormat() == output::Format::Text) {
+        out << "Radius = " << radius << ", Volume = " << volume << '\n';
+      } else {
+        out.Record(radius, volume);
       }
     }
 
-    void HandleValidationFailure(const std::invalid_argument& e) {
+  // Helper Functions
+    static constexpr bool IsValidRadius(double radius) {
+      return radius > 0 && radius <= kMaxRadius; // Also rejects NaN
+    }
+
+    static void HandleValidationFailure(ValidationError error) {
       if (Config::DEVELOPER_MODE) {
-        std::cerr << "[Validation Failure] " << e.what();
+        std::cerr << "[Validation Failure] " << kErrorMessages[static_cast<std::size_t>(error)];
       }
     }
 
@@ -94,13 +168,504 @@ class Sphere {
     double m_radius;
 };
 
-static double CalculateAverageVolume(const std::array<double, kSpheres>& volumes) { 
-  double average_volume{0.0};
-  for (double volume : volumes) { // We need to know the size of the array
-    average_volume += volume;
+// Batch volume kernel: 'out[i] = kVolumeFactor * radii[i]^3' for 'count' spheres. Pure streaming
+// multiplies, so with AVX2/NEON it runs at memory bandwidth; results match 'Sphere::CalculateVolume'
+// bit for bit (same operations in the same order, no FMA contraction).
+static void CalculateVolumes(const double* radii, double* out, std::size_t count) {
+  std::size_t i{0};
+
+  #if SUPPORTS_AVX2
+    const __m256d factor{_mm256_set1_pd(kVolumeFactor)};
+    for (; i + 4 <= count; i += 4) {
+      const __m256d r{_mm256_loadu_pd(radii + i)};
+      const __m256d cube{_mm256_mul_pd(_mm256_mul_pd(r, r), r)};
+      _mm256_storeu_pd(out + i, _mm256_mul_pd(factor, cube));
+    }
+  #elif SUPPORTS_NEON
+    const float64x2_t factor{vdupq_n_f64(kVolumeFactor)};
+    for (; i + 2 <= count; i += 2) {
+      const float64x2_t r{vld1q_f64(radii + i)};
+      const float64x2_t cube{vmulq_f64(vmulq_f64(r, r), r)};
+      vst1q_f64(out + i, vmulq_f64(factor, cube));
+    }
+  #endif // SUPPORTS_AVX2
+
+  for (; i < count; ++i) { // Scalar tail (and the whole range without SIMD)
+    const double r{radii[i]};
+    out[i] = kVolumeFactor * (r * r * r);
+  }
+}
+
+#if SUPPORTS_CPP20
+  // 'out' must be at least as long as 'radii'.
+  inline void CalculateVolumes(std::span<const double> radii, std::span<double> out) {
+    CalculateVolumes(radii.data(), out.data(), std::min(radii.size(), out.size()));
+  }
+#endif // SUPPORTS_CPP20
+
+// Result of 'ValidateRadii': one bit per radius, set where the radius is out of range.
+struct RadiusValidation {
+  static constexpr std::size_t kBitsPerWord{64};
+
+  std::size_t invalid{0};
+  std::vector<std::uint64_t> invalid_bits;
+
+  bool IsInvalid(std::size_t index) const noexcept {
+    return (invalid_bits[index / kBitsPerWord] >> (index % kBitsPerWord)) & 1U;
+  }
+};
+
+// Batch counterpart of 'Sphere::IsValidRadius': flags and counts bad radii in one branchless pass,
+// without constructing any 'Sphere' or exception object.
+static RadiusValidation ValidateRadii(const double* radii, std::size_t count) {
+  RadiusValidation result;
+  result.invalid_bits.assign((count + RadiusValidation::kBitsPerWord - 1) / RadiusValidation::kBitsPerWord, 0);
+
+  for (std::size_t word_index{0}; word_index < result.invalid_bits.size(); ++word_index) {
+    const std::size_t base{word_index * RadiusValidation::kBitsPerWord};
+    const std::size_t lanes{std::min(RadiusValidation::kBitsPerWord, count - base)};
+    const double* values{radii + base};
+    std::uint64_t word{0};
+    std::size_t j{0};
+
+    #if SUPPORTS_AVX2
+      // Ordered compares are false for NaN, so NaN radii count as invalid, as in 'IsValidRadius'.
+      const __m256d zero{_mm256_setzero_pd()};
+      const __m256d max{_mm256_set1_pd(kMaxRadius)};
+      for (; j + 4 <= lanes; j += 4) {
+        const __m256d r{_mm256_loadu_pd(values + j)};
+        const __m256d valid{_mm256_and_pd(_mm256_cmp_pd(r, zero, _CMP_GT_OQ), _mm256_cmp_pd(r, max, _CMP_LE_OQ))};
+        word |= static_cast<std::uint64_t>(~_mm256_movemask_pd(valid) & 0xF) << j;
+      }
+    #endif // SUPPORTS_AVX2
+
+    for (; j < lanes; ++j) {
+      word |= static_cast<std::uint64_t>(!Sphere::IsValidRadius(values[j])) << j;
+    }
+
+    result.invalid_bits[word_index] = word;
+    for (std::uint64_t bits{word}; bits; bits &= bits - 1) ++result.invalid;
+  }
+
+  return result;
+}
+
+// Compensated (Kahan-Babuska/Neumaier) running sum: keeps the rounding error of every addition,
+// so adding millions of volumes of very different magnitudes does not drift like a naive sum.
+class CompensatedSum {
+  public:
+    void Add(double value) noexcept {
+      const double sum{m_sum + value};
+      m_compensation += std::abs(m_sum) >= std::abs(value) ? (m_sum - sum) + value : (value - sum) + m_sum;
+      m_sum = sum;
+    }
+
+    void Add(const CompensatedSum& other) noexcept {
+      Add(other.m_sum);
+      Add(other.m_compensation);
+    }
+
+    double Value() const noexcept { return m_sum + m_compensation; }
+
+  private:
+    double m_sum{0.0};
+    double m_compensation{0.0};
+};
+
+// Summary of a volume column. Partial results from different chunks combine exactly with 'Merge'
+// (Chan et al. pairwise update), which is what makes the parallel reduction numerically stable.
+struct VolumeStatistics {
+  std::size_t count{0};
+  CompensatedSum total;
+  double mean{0.0};
+  double m2{0.0}; // Sum of squared deviations from 'mean'
+  double min{std::numeric_limits<double>::infinity()};
+  double max{-std::numeric_limits<double>::infinity()};
+
+  double Total() const noexcept { return total.Value(); }
+  double Mean() const noexcept { return count ? Total() / static_cast<double>(count) : 0.0; }
+  double Variance() const noexcept { return count ? m2 / static_cast<double>(count) : 0.0; } // Population variance
+
+  void Merge(const VolumeStatistics& other) noexcept {
+    if (other.count == 0) return;
+    if (count == 0) {
+      *this = other;
+      return;
+    }
+
+    const double n_a{static_cast<double>(count)};
+    const double n_b{static_cast<double>(other.count)};
+    const double n{n_a + n_b};
+    const double delta{other.mean - mean};
+
+    mean += delta * (n_b / n);
+    m2 += other.m2 + delta * delta * (n_a * n_b / n);
+    count += other.count;
+    total.Add(other.total);
+    min = std::min(min, other.min);
+    max = std::max(max, other.max);
+  }
+};
+
+// Serial kernel for one contiguous range: two passes per small block (sum, then squared deviations
+// from the block mean) while the block is still in L1, merged block by block.
+static VolumeStatistics CalculateRangeStatistics(const double* volumes, std::size_t count) {
+  constexpr std::size_t kBlock{1'024};
+  VolumeStatistics statistics;
+
+  for (std::size_t begin{0}; begin < count; begin += kBlock) {
+    const std::size_t size{std::min(kBlock, count - begin)};
+    const double* block{volumes + begin};
+
+    VolumeStatistics partial;
+    partial.count = size;
+    for (std::size_t i{0}; i < size; ++i) {
+      partial.total.Add(block[i]);
+      partial.min = std::min(partial.min, block[i]);
+      partial.max = std::max(partial.max, block[i]);
+    }
+
+    partial.mean = partial.total.Value() / static_cast<double>(size);
+    for (std::size_t i{0}; i < size; ++i) {
+      const double deviation{block[i] - partial.mean};
+      partial.m2 += deviation * deviation;
+    }
+
+    statistics.Merge(partial);
+  }
+
+  return statistics;
+}
+
+// Total, mean, min/max and variance of a volume column of any size, split across cores in
+// contiguous chunks (at least 'Config::STATISTICS_MIN_VOLUMES_PER_WORKER' each).
+static VolumeStatistics CalculateVolumeStatistics(const double* volumes, std::size_t count) {
+  TRACE_SCOPE("CalculateVolumeStatistics");
+  const std::vector<VolumeStatistics> partials{reduce::MapSlices<VolumeStatistics>(count, Config::STATISTICS_MIN_VOLUMES_PER_WORKER,
+      [volumes](std::size_t begin, std::size_t end) { return CalculateRangeStatistics(volumes + begin, end - begin); })};
+
+  VolumeStatistics statistics;
+  for (const VolumeStatistics& partial : partials) {
+    statistics.Merge(partial);
+  }
+  return statistics;
+}
+
+#if SUPPORTS_CPP20
+  inline VolumeStatistics CalculateVolumeStatistics(std::span<const double> volumes) {
+    return CalculateVolumeStatistics(volumes.data(), volumes.size());
+  }
+#endif // SUPPORTS_CPP20
+
+// Statistics kept up to date one volume at a time (Welford's update, and its inverse for removals),
+// so adding a sphere or changing a radius is O(1) instead of a rescan of the whole column.
+// Removing a value far larger than the rest cancels most of 'm2'; 'SphereSet::RecalculateStatistics'
+// gives the exact figures again.
+class RunningVolumeStatistics {
+  public:
+    void Add(double volume) noexcept {
+      ++m_statistics.count;
+      m_statistics.total.Add(volume);
+
+      const double delta{volume - m_statistics.mean};
+      m_statistics.mean += delta / static_cast<double>(m_statistics.count);
+      m_statistics.m2 += delta * (volume - m_statistics.mean);
+
+      m_statistics.min = std::min(m_statistics.min, volume);
+      m_statistics.max = std::max(m_statistics.max, volume);
+    }
+
+    void Remove(double volume) noexcept {
+      if (m_statistics.count <= 1) {
+        *this = RunningVolumeStatistics{};
+        return;
+      }
+
+      --m_statistics.count;
+      m_statistics.total.Add(-volume);
+
+      const double delta{volume - m_statistics.mean};
+      m_statistics.mean -= delta / static_cast<double>(m_statistics.count);
+      m_statistics.m2 = std::max(0.0, m_statistics.m2 - delta * (volume - m_statistics.mean));
+
+      // An extreme cannot be undone in O(1); the owner rescans it on the next read.
+      if (volume <= m_statistics.min || volume >= m_statistics.max) m_extremes_stale = true;
+    }
+
+    void Replace(double old_volume, double new_volume) noexcept {
+      Remove(old_volume);
+      Add(new_volume);
+    }
+
+    bool ExtremesStale() const noexcept { return m_extremes_stale; }
+
+    void SetExtremes(double min, double max) noexcept {
+      m_statistics.min = min;
+      m_statistics.max = max;
+      m_extremes_stale = false;
+    }
+
+    const VolumeStatistics& Get() const noexcept { return m_statistics; }
+
+  private:
+    VolumeStatistics m_statistics;
+    bool m_extremes_stale{false};
+};
+
+// Structure-of-arrays sphere collection: only the radii column is stored, densely packed, which is
+// all the batch kernels need; 'Sphere' objects are only built on demand. Volume statistics are
+// maintained incrementally as radii are added or changed.
+class SphereSet {
+  public:
+    static constexpr std::uint32_t kSnapshotKind{snapshot::Kind("SPHR")};
+
+    void Reserve(std::size_t count) { m_radii.reserve(count); }
+
+    // Rejects the same radii as 'Sphere::SetRadius'; returns whether the radius was added.
+    bool Add(double radius) {
+      if (!Sphere::IsValidRadius(radius)) return false;
+      m_radii.push_back(radius);
+      m_statistics.Add(VolumeOf(radius));
+      return true;
+    }
+
+    bool Add(const Sphere& sphere) { return Add(sphere.GetRadius()); }
+
+    // Bulk load: appends the valid radii and reports the rejected ones by input index.
+    RadiusValidation Append(const double* radii, std::size_t count) {
+      RadiusValidation validation{ValidateRadii(radii, count)};
+      // Only grow when the batch does not fit, and then at least geometrically: reserving the exact
+      // size on every call would reallocate on each 'Append' and make repeated small batches quadratic.
+      const std::size_t needed{m_radii.size() + (count - validation.invalid)};
+      if (needed > m_radii.capacity()) m_radii.reserve(std::max(needed, 2 * m_radii.capacity()));
+      for (std::size_t i{0}; i < count; ++i) { // Already validated: no second 'IsValidRadius' per radius
+        if (validation.IsInvalid(i)) continue;
+        m_radii.push_back(radii[i]);
+        m_statistics.Add(VolumeOf(radii[i]));
+      }
+      return validation;
+    }
+
+  // Setter - same contract as 'Sphere::TrySetRadius'; the statistics follow in O(1).
+    std::optional<ValidationError> SetRadius(std::size_t index, double radius) {
+      if (!Sphere::IsValidRadius(radius)) return ValidationError::InvalidRadius;
+
+      m_statistics.Replace(VolumeOf(m_radii[index]), VolumeOf(radius));
+      m_radii[index] = radius;
+      return std::nullopt;
+    }
+
+  // Getters
+    std::size_t Size() const noexcept { return m_radii.size(); }
+    const double* Radii() const noexcept { return m_radii.data(); }
+    Sphere At(std::size_t index) const { return Sphere(m_radii[index]); }
+
+  // Class Methods
+    void CalculateVolumes(double* out) const { ::CalculateVolumes(m_radii.data(), out, m_radii.size()); }
+
+    std::vector<double> CalculateVolumes() const {
+      std::vector<double> volumes(m_radii.size());
+      CalculateVolumes(volumes.data());
+      return volumes;
+    }
+
+    // Every sphere as 'Sphere' would write it, with the volumes from one batch pass.
+    void WriteRecords(output::Writer& out) const { WriteRecords(out, m_radii.data(), m_radii.size()); }
+
+    static void WriteRecords(output::Writer& out, const double* radii, std::size_t count) {
+      std::vector<double> volumes(count);
+      ::CalculateVolumes(radii, volumes.data(), count);
+      out.Header({"radius", "volume"});
+      for (std::size_t i{0}; i < count; ++i) {
+        Sphere::WriteRecord(out, radii[i], volumes[i]);
+      }
+    }
+
+    // Incrementally maintained; only a removed extreme triggers a rescan, and only of min/max.
+    const VolumeStatistics& Statistics() const {
+      if (m_statistics.ExtremesStale()) {
+        // Volume grows with the radius, so the extreme volumes belong to the extreme radii.
+        const auto [min, max] = std::minmax_element(m_radii.begin(), m_radii.end());
+        m_statistics.SetExtremes(VolumeOf(*min), VolumeOf(*max));
+      }
+      return m_statistics.Get();
+    }
+
+    // Full parallel recomputation from the column, e.g. to cross-check the running values.
+    VolumeStatistics RecalculateStatistics() const {
+      const std::vector<double> volumes{CalculateVolumes()};
+      return CalculateVolumeStatistics(volumes.data(), volumes.size());
+    }
+
+    // The radii column and the current statistics, so a 'SphereSetView' has them without a pass.
+    std::error_code SaveSnapshot(const std::string& path) const {
+      return snapshot::Write(path, kSnapshotKind, m_radii.size(), {snapshot::ColumnOf(m_radii), snapshot::ColumnOf(&Statistics(), 1)});
+    }
+
+  private:
+    static double VolumeOf(double radius) noexcept { return kVolumeFactor * (radius * radius * radius); }
+
+    std::vector<double> m_radii;
+    mutable RunningVolumeStatistics m_statistics;
+};
+
+// Read-only 'SphereSet' served from a snapshot file ('SphereSet::SaveSnapshot'). Opening maps the
+// file and checks its header only: the radii are used in place, already validated when they were
+// added to the set, so a restart costs the same for a thousand spheres as for a hundred million.
+class SphereSetView {
+  public:
+    static std::variant<SphereSetView, std::error_code> Open(const std::string& path) {
+      auto opened = snapshot::MappedSnapshot::Open(path, SphereSet::kSnapshotKind);
+      if (const auto* error = std::get_if<std::error_code>(&opened)) return *error;
+
+      SphereSetView view{std::move(std::get<snapshot::MappedSnapshot>(opened))};
+      view.m_radii = view.m_snapshot.Column<double>(0, view.m_snapshot.Rows());
+      view.m_statistics = view.m_snapshot.Column<VolumeStatistics>(1, 1);
+      if (!view.m_radii || !view.m_statistics) return snapshot::make_error_code(snapshot::Error::BadColumn);
+      return view;
+    }
+
+  // Getters
+    std::size_t Size() const noexcept { return m_snapshot.Rows(); }
+    const double* Radii() const noexcept { return m_radii; }
+    Sphere At(std::size_t index) const { return Sphere(m_radii[index]); }
+    const VolumeStatistics& Statistics() const noexcept { return *m_statistics; } // As saved: no pass over the radii
+
+  // Class Methods
+    void CalculateVolumes(double* out) const { ::CalculateVolumes(m_radii, out, Size()); }
+    void WriteRecords(output::Writer& out) const { SphereSet::WriteRecords(out, m_radii, Size()); }
+
+    VolumeStatistics RecalculateStatistics() const {
+      std::vector<double> volumes(Size());
+      CalculateVolumes(volumes.data());
+      return CalculateVolumeStatistics(volumes.data(), volumes.size());
+    }
+
+  private:
+    explicit SphereSetView(snapshot::MappedSnapshot mapped) : m_snapshot(std::move(mapped)) {}
+
+    snapshot::MappedSnapshot m_snapshot;
+    const double* m_radii{nullptr};
+    const VolumeStatistics* m_statistics{nullptr};
+};
+
+// Calls 'on_line(line_number, line)' for every non-blank line, trimmed; line numbers start at 1.
+template<typename Callback>
+void ForEachLine(std::string_view text, Callback&& on_line) {
+  std::size_t line_number{0};
+  while (!text.empty()) {
+    const std::size_t newline{text.find('\n')};
+    const std::string_view line{input::Trim(text.substr(0, newline))};
+    text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+
+    ++line_number;
+    if (!line.empty()) on_line(line_number, line);
   }
+}
+
+// Radii column parsed from bulk input, with the source line of each value for error reports.
+struct BulkRadii {
+  std::vector<double> radii;
+  std::vector<std::size_t> line_numbers;
+  std::size_t malformed{0};
+};
+
+// One radius per line; lines that are not a single number are reported and skipped.
+static BulkRadii ParseRadii(std::string_view text) {
+  BulkRadii input;
+
+  ForEachLine(text, [&input](std::size_t line_number, std::string_view line) {
+    double radius{0.0};
+    const auto [end, error] = std::from_chars(line.data(), line.data() + line.size(), radius);
+
+    if (error != std::errc() || end != line.data() + line.size()) {
+      ++input.malformed;
+      std::cerr << "Line " << line_number << ": non-numeric radius '" << line << "'; skipped.\n";
+      return;
+    }
+
+    input.radii.push_back(radius);
+    input.line_numbers.push_back(line_number);
+  });
 
-  return average_volume / kSpheres;
+  return input;
+}
+
+static void PrintStatistics(std::ostream& summary, const VolumeStatistics& statistics) {
+  if (statistics.count) {
+    summary << "Total Volume = " << statistics.Total() << ", Average Volume = " << statistics.Mean()
+            << ", Min = " << statistics.min << ", Max = " << statistics.max << ", Variance = " << statistics.Variance() << '\n';
+  }
+}
+
+// Usage: run.exe --bulk [file|-] [text|csv|binary] - reads radii from 'file' (or standard input) and prints a
+// summary. With a format, every valid sphere is written first; for CSV and binary the summary and the
+// diagnostics then go to standard error, so standard output holds the records only.
+// Usage: run.exe --save-snapshot <snapshot> [file|-] - the same input, saved as a snapshot for '--load-snapshot'.
+static int RunBulkMode(const char* path, std::optional<output::Format> format, const char* snapshot_path = nullptr) {
+  std::FILE* stream{path ? std::fopen(path, "rb") : stdin};
+  if (!stream) {
+    std::cerr << "Error: Cannot open '" << path << "'.\n";
+    return EXIT_FAILURE;
+  }
+
+  const std::string text{input::ReadAll(stream)};
+  if (path) std::fclose(stream);
+
+  const BulkRadii input{ParseRadii(text)};
+  SphereSet spheres;
+  spheres.Reserve(input.radii.size());
+  const RadiusValidation validation{spheres.Append(input.radii.data(), input.radii.size())};
+
+  if (validation.invalid) {
+    for (std::size_t i{0}; i < input.radii.size(); ++i) {
+      if (validation.IsInvalid(i)) {
+        std::cerr << "Line " << input.line_numbers[i] << ": " << kErrorMessages[static_cast<std::size_t>(ValidationError::InvalidRadius)];
+      }
+    }
+  }
+
+  if (format) {
+    output::Writer out{stdout, *format};
+    spheres.WriteRecords(out);
+  } // Flushed here, before the summary
+
+  if (snapshot_path) {
+    if (const std::error_code error{spheres.SaveSnapshot(snapshot_path)}) {
+      std::cerr << "Error: Cannot write '" << snapshot_path << "': " << error.message() << '\n';
+      return EXIT_FAILURE;
+    }
+  }
+
+  std::ostream& summary{format && *format != output::Format::Text ? std::cerr : std::cout};
+  const VolumeStatistics& statistics{spheres.Statistics()};
+  summary << "Spheres = " << statistics.count << " (malformed lines: " << input.malformed
+          << ", invalid radii: " << validation.invalid << ")\n";
+  PrintStatistics(summary, statistics);
+
+  return input.malformed || validation.invalid ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// Usage: run.exe --load-snapshot <snapshot> [text|csv|binary] - the '--bulk' summary (and records, with a
+// format) of a saved snapshot, read through the mapping instead of parsed.
+static int RunSnapshotMode(const char* snapshot_path, std::optional<output::Format> format) {
+  auto opened = SphereSetView::Open(snapshot_path);
+  if (const auto* error = std::get_if<std::error_code>(&opened)) {
+    std::cerr << "Error: Cannot load '" << snapshot_path << "': " << error->message() << '\n';
+    return EXIT_FAILURE;
+  }
+  const SphereSetView& spheres{std::get<SphereSetView>(opened)};
+
+  if (format) {
+    output::Writer out{stdout, *format};
+    spheres.WriteRecords(out);
+  }
+
+  std::ostream& summary{format && *format != output::Format::Text ? std::cerr : std::cout};
+  summary << "Spheres = " << spheres.Size() << " (from snapshot)\n";
+  PrintStatistics(summary, spheres.Statistics());
+
+  return EXIT_SUCCESS;
 }
 
 static bool IsValidSphere(double& radius) {
@@ -114,13 +679,134 @@ static bool IsValidSphere(double& radius) {
   return true;
 }
 
+#if BENCHMARK_ENABLED
+// Usage: run.exe --benchmark [max_spheres] - volumes of random valid spheres one 'Sphere' at a time and
+// through the batch kernel, the column statistics (and 'reduce::max_of' on the volumes), the listing (stream versus 'output::Writer') and a restart
+// (parsing text versus mapping a snapshot), from 1K up to 'max_spheres' (default 10M).
+static int RunVolumeBenchmark(std::size_t max_spheres) {
+  bench::Generator generator;
+  bench::PrintHeader();
+
+  for (std::size_t count : bench::Scales(max_spheres)) {
+    std::vector<double> radii(count);
+    for (double& radius : radii) radius = generator.UniformReal(1.0, kMaxRadius);
+
+    std::vector<Sphere> spheres;
+    spheres.reserve(count);
+    for (double radius : radii) spheres.emplace_back(radius);
+    std::vector<double> volumes(count);
+
+    bench::Run("Sphere::CalculateVolume", count, [&] {
+      for (std::size_t i{0}; i < count; ++i) volumes[i] = spheres[i].CalculateVolume();
+      bench::DoNotOptimize(volumes.data());
+    });
+    bench::Run("CalculateVolumes (batch)", count, [&] {
+      CalculateVolumes(radii.data(), volumes.data(), count);
+      bench::DoNotOptimize(volumes.data());
+    });
+    VolumeStatistics statistics;
+    bench::Run("CalculateVolumeStatistics", count, [&] { statistics = CalculateVolumeStatistics(volumes.data(), count); });
+    double largest{0.0};
+    bench::Run("reduce::max_of (volumes)", count, [&] { largest = reduce::max_of(volumes); });
+    if (largest != statistics.max) {
+      std::cerr << "Error: the largest volume disagrees at " << count << " spheres (" << largest << ", " << statistics.max << ").\n";
+      return EXIT_FAILURE;
+    }
+
+    SphereSet set;
+    bench::Run("SphereSet::Append", count, [&] { set = SphereSet(); }, [&] {
+      set.Reserve(count);
+      bench::DoNotOptimize(set.Append(radii.data(), count));
+    });
+
+    // Listing the set: one 'operator<<' per sphere versus the buffered writer.
+    std::ofstream null_stream{bench::kNullDevice};
+    bench::Run("operator<< (std::ofstream)", count, [&] {
+      for (std::size_t i{0}; i < set.Size(); ++i) null_stream << set.At(i) << '\n';
+      null_stream.flush();
+    });
+    for (const output::Format format : {output::Format::Text, output::Format::Csv, output::Format::Binary}) {
+      std::FILE* null_file{std::fopen(bench::kNullDevice, "wb")};
+      if (!null_file) break;
+      const char* name{format == output::Format::Text ? "SphereSet::WriteRecords (text)"
+                       : format == output::Format::Csv ? "SphereSet::WriteRecords (csv)" : "SphereSet::WriteRecords (binary)"};
+      bench::Run(name, count, [&] {
+        output::Writer out{null_file, format};
+        set.WriteRecords(out);
+      });
+      std::fclose(null_file);
+    }
+
+    // Restart cost: parsing the radii as text versus mapping a snapshot of the set.
+    std::string text;
+    text.reserve(count * 20);
+    for (double radius : radii) {
+      char digits[32];
+      text.append(digits, std::to_chars(digits, digits + sizeof(digits), radius).ptr).push_back('\n');
+    }
+    bench::Run("ParseRadii + SphereSet::Append", count, [&] {
+      const BulkRadii input{ParseRadii(text)};
+      SphereSet parsed;
+      parsed.Reserve(input.radii.size());
+      bench::DoNotOptimize(parsed.Append(input.radii.data(), input.radii.size()));
+    });
+
+    const std::string path{bench::TemporaryPath("spheres.snapshot")};
+    bench::Run("SphereSet::SaveSnapshot", count, [&] { bench::DoNotOptimize(set.SaveSnapshot(path)); });
+    bench::Run("SphereSetView::Open", count, [&] { bench::DoNotOptimize(SphereSetView::Open(path).index()); });
+
+    auto opened = SphereSetView::Open(path);
+    const SphereSetView* view{std::get_if<SphereSetView>(&opened)};
+    if (!view || view->Size() != set.Size() || view->Statistics().Total() != set.Statistics().Total()) {
+      std::cerr << "Error: the snapshot does not match the set at " << count << " spheres.\n";
+      return EXIT_FAILURE;
+    }
+    bench::Run("RecalculateStatistics (view)", count, [&] { bench::DoNotOptimize(view->RecalculateStatistics()); });
+
+    std::error_code ignored;
+    std::filesystem::remove(path, ignored);
+  }
+
+  return EXIT_SUCCESS;
+}
+#endif // BENCHMARK_ENABLED
+
 
-int main() {
-  // Effectively handle a vector
-  std::vector<Sphere> spheres;
-  spheres.reserve(kSpheres);
+int main(int argc, char* argv[]) {
+  if (argc > 1 && std::string_view(argv[1]) == "--bulk") {
+    const std::optional<output::Format> format{argc > 3 ? output::ParseFormat(argv[3]) : std::nullopt};
+    if (argc > 3 && !format) {
+      std::cerr << "Error: Unknown format '" << argv[3] << "' (expected text, csv or binary).\n";
+      return EXIT_FAILURE;
+    }
+    return RunBulkMode(argc > 2 && std::string_view(argv[2]) != "-" ? argv[2] : nullptr, format);
+  }
 
-  std::array<double, kSpheres> volumes{{}};
+  if (argc > 2 && std::string_view(argv[1]) == "--save-snapshot") {
+    return RunBulkMode(argc > 3 && std::string_view(argv[3]) != "-" ? argv[3] : nullptr, std::nullopt, argv[2]);
+  }
+
+  if (argc > 2 && std::string_view(argv[1]) == "--load-snapshot") {
+    const std::optional<output::Format> format{argc > 3 ? output::ParseFormat(argv[3]) : std::nullopt};
+    if (argc > 3 && !format) {
+      std::cerr << "Error: Unknown format '" << argv[3] << "' (expected text, csv or binary).\n";
+      return EXIT_FAILURE;
+    }
+    return RunSnapshotMode(argv[2], format);
+  }
+
+  if (argc > 1 && std::string_view(argv[1]) == "--benchmark") {
+    #if BENCHMARK_ENABLED
+      return RunVolumeBenchmark(bench::ParseCount(argc > 2 ? argv[2] : nullptr, 10'000'000));
+    #else
+      std::cerr << "Error: '--benchmark' needs a build with -DENABLE_BENCHMARK.\n";
+      return EXIT_FAILURE;
+    #endif // BENCHMARK_ENABLED
+  }
+
+  // Effectively handle a vector (of radii; the statistics are kept up to date as spheres are added)
+  SphereSet spheres;
+  spheres.Reserve(kSpheres);
 
   {
     double input_radius{0.0};
@@ -131,16 +817,14 @@ int main() {
         continue;
       }
 
-      spheres.emplace_back(input_radius);
-      volumes[i] = spheres.back().CalculateVolume(); // Same as creating a 'Sphere' object and doing 'spheres[i].SetRadius(radius);'
+      spheres.Add(Sphere(input_radius)); // Constructing the 'Sphere' applies the fallback radius to bad input
     }
 
-    for (const Sphere& sphere : spheres) {
-      std::cout << sphere << '\n';
-    }
+    output::Writer out{stdout, output::Format::Text, 4'096};
+    spheres.WriteRecords(out);
   }
 
-  std::cout << "Average Volume = " << CalculateAverageVolume(volumes) << '\n';
+  std::cout << "Average Volume = " << spheres.Statistics().Mean() << '\n';
 
   return 0;
 }
@@ -7,31 +7,82 @@
 #include <cstdint>
 #include <vector>
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <charconv> // 'std::from_chars' for the snapshot input
+#include <condition_variable>
+#include <cstddef>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <set>
+#include <string>
+#include <string_view>
+#include <system_error>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <filesystem>
 #include <optional> // Include compiler flag: -std=c++17
+#include "../common/trace.h" // Lifecycle events and timings; compiled out unless -DENABLE_TRACING
+#include "../common/bench.h" // '--benchmark' harness and data generators; compiled out unless -DENABLE_BENCHMARK
+#include "../common/output.h" // Buffered text/CSV/binary reports
+#include "../common/input.h" // Whole-stream reads for '--save-snapshot'
+#include "../common/snapshot.h" // Binary snapshots loaded by memory mapping
+#include "../common/reduce.h" // 'argmax' over the size column
+
+// Compile with '-mavx2' (or '-march=native') to enable the vectorized size kernels.
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define SUPPORTS_AVX2 1
+#else
+  #define SUPPORTS_AVX2 0
+#endif // __AVX2__
+
+// 'std::execution' is only really parallel with MSVC, or libstdc++/libc++ built against TBB; compile
+// with '-DUSE_PARALLEL_STL' (and link '-ltbb') to use it, otherwise the in-house pool is used.
+#if defined(_MSC_VER) || defined(USE_PARALLEL_STL)
+  #include <execution>
+  #define SUPPORTS_PARALLEL_STL 1
+#else
+  #define SUPPORTS_PARALLEL_STL 0
+#endif // _MSC_VER
 
 namespace Config {
   constexpr bool DEVELOPER_MODE = false;
-  constexpr bool CONFIDENTIAL_OVERRIDE = false;
+
+  // Below this many images 'Sort'/'ReverseSort' use 'std::sort'; the radix passes only pay off above it.
+  constexpr std::size_t RADIX_SORT_MIN_IMAGES = 1 << 12;
 }
 
 constexpr std::uint8_t kImages = 4;
 
+// Largest size 'ValidateParameters' allows: 7,680 * 4,320 * 128 - just below 2^32.
+constexpr std::uint32_t kMaxImageSize = 7'680U * 4'320U * 128U;
+
+// Widened to 32 bits before multiplying, so the largest valid image does not overflow 'int'.
+constexpr std::uint32_t ComputeSizeKey(std::uint16_t width, std::uint16_t height, std::uint8_t color_depth) {
+  return static_cast<std::uint32_t>(width) * height * color_depth;
+}
+
 class Image {
   public:
   // Constructors and Destructor
     Image() : m_width(1920), m_height(1080), m_color_depth(6) {
-      if (Config::DEVELOPER_MODE) {
-        std::cout << "Default constructor running for image '1920x1080, 6'.\n";
-      }
+      TRACE_OBJECT_CREATED("Image", this);
     }
 
     explicit Image(std::uint16_t width, std::uint16_t height, std::uint8_t color_depth)
         : m_width(width), m_height(height), m_color_depth(color_depth) {
+          TRACE_OBJECT_CREATED("Image", this);
+
           try {
             ValidateParameters(m_width, m_height, m_color_depth);
-            if (Config::DEVELOPER_MODE) {
-              std::cout << "Parameterized constructor (3/3) running for image '" << width << 'x' << height << ", " << color_depth << "'.\n";
-            }
           } catch (const std::invalid_argument& e) {
             HandleValidationFailure(e);
 
@@ -44,12 +95,18 @@ class Image {
     }
 
     ~Image() noexcept {
-      if (Config::DEVELOPER_MODE && Config::CONFIDENTIAL_OVERRIDE) {
-        std::cout << "Destructor running for image '" << m_width << 'x' << m_height << ", " << m_color_depth << "'.\n";
-      }
+      TRACE_OBJECT_DESTROYED("Image", this);
+    }
+
+  // Getters
+    std::uint16_t GetWidth() const {
+      return m_width;
+    }
+
+    std::uint16_t GetHeight() const {
+      return m_height;
     }
 
-  // Getter
     std::uint8_t GetColorDepth() const {
       return m_color_depth;
     }
@@ -68,7 +125,8 @@ class Image {
 
   // Class Method
     unsigned long int GetSize() const {
-      return m_width * m_height * static_cast<int>(m_color_depth);
+      // 'uint16_t * uint16_t' promotes to 'int', which overflows for large images; widen first.
+      return ComputeSizeKey(m_width, m_height, m_color_depth);
     }
 
   // Overloaded Operator Functions
@@ -80,9 +138,19 @@ class Image {
       return os << "Width = " << image.m_width << ", Height = " << image.m_height
                 << ", Depth = " << static_cast<int>(image.m_color_depth) << ", Size = " << image.GetSize();
     }
+
+    // Bulk output: the 'operator<<' line, or one CSV/binary record 'width, height, color_depth, size'.
+    friend void WriteRecord(output::Writer& out, const Image& image) {
+      if (out.GetFormat() == output::Format::Text) {
+        out << "Width = " << image.m_width << ", Height = " << image.m_height
+            << ", Depth = " << image.m_color_depth << ", Size = " << image.GetSize() << '\n';
+      } else {
+        out.Record(image.m_width, image.m_height, image.m_color_depth, image.GetSize());
+      }
+    }
   
   // Helper Functions
-    void ValidateParameters(std::optional<std::uint16_t> width, std::optional<std::uint16_t> height, std::uint8_t color_depth) {
+    static void ValidateParameters(std::optional<std::uint16_t> width, std::optional<std::uint16_t> height, std::uint8_t color_depth) {
       // Instead of 'std::optional', use sentinel values (0, -1, etc.) and obviously don't throw an exception for that value.
       // E.g.: I can only compile until C++17 with a compiler flag, while at the same time, the macro '#if __cplusplus >= 201703L' would fail.
       if (color_depth == 0 || color_depth > 128 || (!(color_depth == 1 || color_depth == 3) && (color_depth % 2) != 0)) {
@@ -124,27 +192,1230 @@ bool CompareDescending(const Image& a, const Image& b) {
     return a.GetSize() > b.GetSize();
 }
 
-std::vector<Image> Sort(std::vector<Image>& images) {
-  std::sort(images.begin(), images.end(), CompareAscending);
-  // Alternatively with lambdas: [](const Image& a, const Image& b) { ... }
+enum class SortOrder {
+  Ascending,
+  Descending
+};
+
+// Structure-of-arrays image catalog for capacity planning: three dense columns (5 bytes per image,
+// no padding) that the batch kernels below stream through.
+class ImageColumns {
+  public:
+    static constexpr std::uint32_t kSnapshotKind{snapshot::Kind("IMGC")};
+
+    static ImageColumns From(const std::vector<Image>& images) {
+      ImageColumns columns;
+      columns.Reserve(images.size());
+      for (const Image& image : images) {
+        columns.Append(image);
+      }
+      return columns;
+    }
+
+    void Reserve(std::size_t count) {
+      m_widths.reserve(count);
+      m_heights.reserve(count);
+      m_color_depths.reserve(count);
+    }
+
+    void Append(const Image& image) {
+      m_widths.push_back(image.GetWidth());
+      m_heights.push_back(image.GetHeight());
+      m_color_depths.push_back(image.GetColorDepth());
+    }
+
+  // Getters
+    std::size_t Size() const noexcept { return m_widths.size(); }
+    const std::uint16_t* Widths() const noexcept { return m_widths.data(); }
+    const std::uint16_t* Heights() const noexcept { return m_heights.data(); }
+    const std::uint8_t* ColorDepths() const noexcept { return m_color_depths.data(); }
+
+    // The three columns as is, for 'ImageColumnsView'.
+    std::error_code SaveSnapshot(const std::string& path) const {
+      return snapshot::Write(path, kSnapshotKind, Size(),
+                             {snapshot::ColumnOf(m_widths), snapshot::ColumnOf(m_heights), snapshot::ColumnOf(m_color_depths)});
+    }
+
+  private:
+    std::vector<std::uint16_t> m_widths;
+    std::vector<std::uint16_t> m_heights;
+    std::vector<std::uint8_t> m_color_depths;
+};
+
+// Read-only 'ImageColumns' served from a snapshot file ('ImageColumns::SaveSnapshot'): the same
+// getters, pointing into the mapping, so the batch kernels below run on it unchanged.
+class ImageColumnsView {
+  public:
+    static std::variant<ImageColumnsView, std::error_code> Open(const std::string& path) {
+      auto opened = snapshot::MappedSnapshot::Open(path, ImageColumns::kSnapshotKind);
+      if (const auto* error = std::get_if<std::error_code>(&opened)) return *error;
+
+      ImageColumnsView view{std::move(std::get<snapshot::MappedSnapshot>(opened))};
+      const std::size_t rows{view.m_snapshot.Rows()};
+      view.m_widths = view.m_snapshot.Column<std::uint16_t>(0, rows);
+      view.m_heights = view.m_snapshot.Column<std::uint16_t>(1, rows);
+      view.m_color_depths = view.m_snapshot.Column<std::uint8_t>(2, rows);
+      if (!view.m_widths || !view.m_heights || !view.m_color_depths) return snapshot::make_error_code(snapshot::Error::BadColumn);
+      return view;
+    }
+
+  // Getters
+    std::size_t Size() const noexcept { return m_snapshot.Rows(); }
+    const std::uint16_t* Widths() const noexcept { return m_widths; }
+    const std::uint16_t* Heights() const noexcept { return m_heights; }
+    const std::uint8_t* ColorDepths() const noexcept { return m_color_depths; }
+    Image At(std::size_t index) const { return Image(m_widths[index], m_heights[index], m_color_depths[index]); }
+
+  private:
+    explicit ImageColumnsView(snapshot::MappedSnapshot mapped) : m_snapshot(std::move(mapped)) {}
+
+    snapshot::MappedSnapshot m_snapshot;
+    const std::uint16_t* m_widths{nullptr};
+    const std::uint16_t* m_heights{nullptr};
+    const std::uint8_t* m_color_depths{nullptr};
+};
+
+// Batch 'ComputeSizeKey': 'out[i] = widths[i] * heights[i] * color_depths[i]', widened to 32 bits.
+// With AVX2, eight images per iteration (the product of valid images is exact in 32-bit lanes).
+void ComputeSizes(const std::uint16_t* widths, const std::uint16_t* heights, const std::uint8_t* color_depths,
+                  std::uint32_t* out, std::size_t count) {
+  std::size_t i{0};
+
+  #if SUPPORTS_AVX2
+    for (; i + 8 <= count; i += 8) {
+      const __m256i width{_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(widths + i)))};
+      const __m256i height{_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(heights + i)))};
+      const __m256i depth{_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(color_depths + i)))};
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), _mm256_mullo_epi32(_mm256_mullo_epi32(width, height), depth));
+    }
+  #endif // SUPPORTS_AVX2
+
+  for (; i < count; ++i) {
+    out[i] = ComputeSizeKey(widths[i], heights[i], color_depths[i]);
+  }
+}
+
+// 'Columns' is an 'ImageColumns' or an 'ImageColumnsView', here and in the kernels below.
+template<typename Columns>
+std::vector<std::uint32_t> ComputeSizes(const Columns& columns) {
+  std::vector<std::uint32_t> sizes(columns.Size());
+  ComputeSizes(columns.Widths(), columns.Heights(), columns.ColorDepths(), sizes.data(), sizes.size());
+  return sizes;
+}
+
+// Per-image sizes straight from 'std::vector<Image>', for the sorts; computed once, not per comparison.
+std::vector<std::uint32_t> ComputeSizes(const std::vector<Image>& images) {
+  std::vector<std::uint32_t> sizes(images.size());
+  for (std::size_t i{0}; i < images.size(); ++i) {
+    sizes[i] = ComputeSizeKey(images[i].GetWidth(), images[i].GetHeight(), images[i].GetColorDepth());
+  }
+  return sizes;
+}
+
+// Sum of all sizes with 64-bit accumulators: a catalog total passes 2^32 after a couple of large images.
+template<typename Columns>
+std::uint64_t TotalFootprint(const Columns& columns) {
+  const std::uint16_t* widths{columns.Widths()};
+  const std::uint16_t* heights{columns.Heights()};
+  const std::uint8_t* color_depths{columns.ColorDepths()};
+  const std::size_t count{columns.Size()};
+  std::uint64_t total{0};
+  std::size_t i{0};
+
+  #if SUPPORTS_AVX2
+    __m256i low_sum{_mm256_setzero_si256()};
+    __m256i high_sum{_mm256_setzero_si256()};
+    for (; i + 8 <= count; i += 8) {
+      const __m256i width{_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(widths + i)))};
+      const __m256i height{_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(heights + i)))};
+      const __m256i depth{_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(color_depths + i)))};
+      const __m256i size{_mm256_mullo_epi32(_mm256_mullo_epi32(width, height), depth)};
+
+      // Zero-extend each half of the eight 32-bit sizes to 64 bits before accumulating.
+      low_sum = _mm256_add_epi64(low_sum, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(size)));
+      high_sum = _mm256_add_epi64(high_sum, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(size, 1)));
+    }
+
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(low_sum, high_sum));
+    total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  #endif // SUPPORTS_AVX2
+
+  for (; i < count; ++i) {
+    total += ComputeSizeKey(widths[i], heights[i], color_depths[i]);
+  }
+  return total;
+}
+
+struct DepthBucket {
+  std::uint64_t images{0};
+  std::uint64_t footprint{0};
+};
+
+// Capacity report: catalog-wide totals plus a histogram indexed by color depth. One bucket per 'uint8_t'
+// value, not just the valid 1..128: an 'ImageColumnsView' serves a snapshot's depths unchecked.
+struct CapacityReport {
+  std::uint64_t images{0};
+  std::uint64_t total_footprint{0};
+  std::array<DepthBucket, 256> by_depth{};
+};
+
+// Sizes are computed a block at a time with the vector kernel (the block stays in L1), then scattered
+// into the depth histogram; the grand total is the sum of the buckets, so the columns are read once.
+template<typename Columns>
+CapacityReport BuildCapacityReport(const Columns& columns) {
+  constexpr std::size_t kBlock{4'096};
+  std::array<std::uint32_t, kBlock> sizes;
+  CapacityReport report;
+  report.images = columns.Size();
+
+  for (std::size_t begin{0}; begin < columns.Size(); begin += kBlock) {
+    const std::size_t count{std::min(kBlock, columns.Size() - begin)};
+    const std::uint8_t* color_depths{columns.ColorDepths() + begin};
+    ComputeSizes(columns.Widths() + begin, columns.Heights() + begin, color_depths, sizes.data(), count);
+
+    for (std::size_t i{0}; i < count; ++i) {
+      DepthBucket& bucket{report.by_depth[color_depths[i]]};
+      ++bucket.images;
+      bucket.footprint += sizes[i];
+    }
+  }
+
+  for (const DepthBucket& bucket : report.by_depth) {
+    report.total_footprint += bucket.footprint;
+  }
+  return report;
+}
+
+void PrintCapacityReport(const CapacityReport& report) {
+  output::Writer out{stdout};
+  out << "Capacity: " << report.images << " images, " << report.total_footprint << " bits\n";
+  for (std::size_t depth{0}; depth < report.by_depth.size(); ++depth) {
+    const DepthBucket& bucket{report.by_depth[depth]};
+    if (bucket.images == 0) continue;
+    out << "  Depth " << depth << ": " << bucket.images << " images, " << bucket.footprint << " bits\n";
+  }
+}
+
+// Precomputed sort keys: the size goes in the high 32 bits (it always fits, see 'kMaxImageSize') and
+// the image's index in the low 32 bits, so sorting the keys also carries the permutation along.
+// 'sizes' come from 'ComputeSizes', instead of two 'GetSize' calls per comparison in 'CompareAscending'.
+std::vector<std::uint64_t> BuildSizeKeys(const std::vector<std::uint32_t>& sizes, SortOrder order) {
+  std::vector<std::uint64_t> keys(sizes.size());
+  for (std::size_t i{0}; i < sizes.size(); ++i) {
+    std::uint32_t size{sizes[i]};
+    if (order == SortOrder::Descending) size = ~size; // Reverses the order while equal sizes stay stable
+    keys[i] = (static_cast<std::uint64_t>(size) << 32) | static_cast<std::uint32_t>(i);
+  }
+  return keys;
+}
+
+// LSD radix sort on the high 32 bits of 'keys': four stable 8-bit counting passes, O(n) instead of
+// O(n log n) compares. All four histograms are built in one read, and a pass whose digit is the same
+// for every key (e.g. the top byte of small sizes) is skipped.
+void RadixSortSizeKeys(std::vector<std::uint64_t>& keys) {
+  constexpr std::size_t kPasses{4};
+  constexpr std::size_t kBuckets{256};
+  std::vector<std::array<std::size_t, kBuckets>> counts(kPasses, std::array<std::size_t, kBuckets>{});
+
+  for (std::uint64_t key : keys) {
+    for (std::size_t pass{0}; pass < kPasses; ++pass) {
+      ++counts[pass][(key >> (32 + 8 * pass)) & 0xFF];
+    }
+  }
+
+  std::vector<std::uint64_t> buffer(keys.size());
+  for (std::size_t pass{0}; pass < kPasses; ++pass) {
+    const std::size_t shift{32 + 8 * pass};
+    std::array<std::size_t, kBuckets>& offsets{counts[pass]};
+    if (!keys.empty() && offsets[(keys.front() >> shift) & 0xFF] == keys.size()) continue;
+
+    std::size_t offset{0};
+    for (std::size_t& bucket : offsets) { // Counts become starting offsets
+      const std::size_t count{bucket};
+      bucket = offset;
+      offset += count;
+    }
+
+    for (std::uint64_t key : keys) {
+      buffer[offsets[(key >> shift) & 0xFF]++] = key;
+    }
+    keys.swap(buffer);
+  }
+}
+
+// Sort engine: key once, radix sort the keys, then apply the permutation with one gather. Stable, so
+// images of equal size keep their order. Limited to 2^32 images by the key layout.
+// 'sizes[i]' must be the size of 'images[i]', e.g. reused from a capacity-planning pass.
+void RadixSort(std::vector<Image>& images, const std::vector<std::uint32_t>& sizes, SortOrder order = SortOrder::Ascending) {
+  if (images.size() > std::numeric_limits<std::uint32_t>::max()) {
+    std::stable_sort(images.begin(), images.end(), order == SortOrder::Ascending ? CompareAscending : CompareDescending);
+    return;
+  }
+
+  std::vector<std::uint64_t> keys{BuildSizeKeys(sizes, order)};
+  RadixSortSizeKeys(keys);
+
+  std::vector<Image> sorted;
+  sorted.reserve(images.size());
+  for (std::uint64_t key : keys) {
+    sorted.push_back(images[static_cast<std::uint32_t>(key)]);
+  }
+  images.swap(sorted);
+}
+
+void RadixSort(std::vector<Image>& images, SortOrder order = SortOrder::Ascending) {
+  RadixSort(images, ComputeSizes(images), order);
+}
+
+// Trivially copyable 4-byte image record (an 'Image' is 6 with padding, and its destructor is not
+// trivial), so sorting and scanning move plain words. 'ValidateParameters' allows only even widths
+// and heights, which lets them be stored halved:
+//   bits  0-11: width / 2 (20..3,840)   bits 12-23: height / 2 (13..2,160)   bits 24-30: depth - 1 (0..127)
+class PackedImage {
+  public:
+    PackedImage() = default;
+
+    explicit PackedImage(const Image& image) // 'Image' is always valid, so packing cannot fail
+        : m_bits(static_cast<std::uint32_t>(image.GetWidth() / 2)
+               | static_cast<std::uint32_t>(image.GetHeight() / 2) << 12
+               | static_cast<std::uint32_t>(image.GetColorDepth() - 1) << 24) {}
+
+    Image ToImage() const {
+      return Image(GetWidth(), GetHeight(), GetColorDepth());
+    }
+
+  // Getters
+    std::uint16_t GetWidth() const {
+      return static_cast<std::uint16_t>((m_bits & 0xFFFU) * 2);
+    }
+
+    std::uint16_t GetHeight() const {
+      return static_cast<std::uint16_t>((m_bits >> 12 & 0xFFFU) * 2);
+    }
+
+    std::uint8_t GetColorDepth() const {
+      return static_cast<std::uint8_t>((m_bits >> 24 & 0x7FU) + 1);
+    }
+
+    std::uint32_t GetSize() const {
+      return ComputeSizeKey(GetWidth(), GetHeight(), GetColorDepth());
+    }
+
+  private:
+    std::uint32_t m_bits{0};
+};
+
+static_assert(std::is_trivially_copyable_v<PackedImage> && sizeof(PackedImage) == 4,
+              "'PackedImage' must stay a plain 32-bit word");
+
+// Contiguous pool of packed records: the compact counterpart of 'std::vector<Image>'. Convert at the
+// edges with 'From'/'ToImages' and keep the bulk work (sorting, footprint scans) in here.
+class PackedImageStore {
+  public:
+    static constexpr std::uint32_t kSnapshotKind{snapshot::Kind("IMGP")};
+
+    static PackedImageStore From(const std::vector<Image>& images) {
+      PackedImageStore store;
+      store.Reserve(images.size());
+      for (const Image& image : images) {
+        store.Add(image);
+      }
+      return store;
+    }
+
+    std::vector<Image> ToImages() const {
+      std::vector<Image> images;
+      images.reserve(m_images.size());
+      for (PackedImage image : m_images) {
+        images.push_back(image.ToImage());
+      }
+      return images;
+    }
+
+    void Reserve(std::size_t count) {
+      m_images.reserve(count);
+    }
+
+    void Add(const Image& image) {
+      m_images.emplace_back(image);
+    }
+
+    void Add(std::uint16_t width, std::uint16_t height, std::uint8_t color_depth) {
+      m_images.emplace_back(Image(width, height, color_depth)); // Validated (with fallback) by 'Image'
+    }
+
+    // Same engine as 'RadixSort' above, but the final gather copies 4-byte words.
+    void Sort(SortOrder order = SortOrder::Ascending) {
+      if (m_images.size() < Config::RADIX_SORT_MIN_IMAGES || m_images.size() > std::numeric_limits<std::uint32_t>::max()) {
+        std::stable_sort(m_images.begin(), m_images.end(), [order](PackedImage a, PackedImage b) {
+          return order == SortOrder::Ascending ? a.GetSize() < b.GetSize() : a.GetSize() > b.GetSize();
+        });
+        return;
+      }
+
+      std::vector<std::uint32_t> sizes(m_images.size());
+      for (std::size_t i{0}; i < m_images.size(); ++i) {
+        sizes[i] = m_images[i].GetSize();
+      }
+      std::vector<std::uint64_t> keys{BuildSizeKeys(sizes, order)};
+      RadixSortSizeKeys(keys);
+
+      std::vector<PackedImage> sorted(m_images.size());
+      for (std::size_t i{0}; i < keys.size(); ++i) {
+        sorted[i] = m_images[static_cast<std::uint32_t>(keys[i])];
+      }
+      m_images.swap(sorted);
+    }
+
+    std::uint64_t TotalFootprint() const {
+      std::uint64_t total{0};
+      for (PackedImage image : m_images) {
+        total += image.GetSize();
+      }
+      return total;
+    }
+
+  // Getters
+    std::size_t Size() const {
+      return m_images.size();
+    }
+
+    PackedImage operator[](std::size_t index) const {
+      return m_images[index];
+    }
+
+    const std::vector<PackedImage>& Records() const {
+      return m_images;
+    }
+
+    // The records in their current order (a sorted store loads sorted), for 'PackedImageView'.
+    std::error_code SaveSnapshot(const std::string& path) const {
+      return snapshot::Write(path, kSnapshotKind, m_images.size(), {snapshot::ColumnOf(m_images)});
+    }
+
+  private:
+    std::vector<PackedImage> m_images;
+};
+
+// Read-only 'PackedImageStore' served from a snapshot file: the 4-byte records are used in place,
+// and 'At' unpacks one into an 'Image' only when it is asked for.
+class PackedImageView {
+  public:
+    static std::variant<PackedImageView, std::error_code> Open(const std::string& path) {
+      auto opened = snapshot::MappedSnapshot::Open(path, PackedImageStore::kSnapshotKind);
+      if (const auto* error = std::get_if<std::error_code>(&opened)) return *error;
+
+      PackedImageView view{std::move(std::get<snapshot::MappedSnapshot>(opened))};
+      view.m_images = view.m_snapshot.Column<PackedImage>(0, view.m_snapshot.Rows());
+      if (!view.m_images) return snapshot::make_error_code(snapshot::Error::BadColumn);
+      return view;
+    }
+
+    std::uint64_t TotalFootprint() const {
+      std::uint64_t total{0};
+      for (std::size_t i{0}; i < Size(); ++i) {
+        total += m_images[i].GetSize();
+      }
+      return total;
+    }
+
+  // Getters
+    std::size_t Size() const noexcept { return m_snapshot.Rows(); }
+    PackedImage operator[](std::size_t index) const { return m_images[index]; }
+    Image At(std::size_t index) const { return m_images[index].ToImage(); }
+    const PackedImage* Records() const noexcept { return m_images; }
+
+  private:
+    explicit PackedImageView(snapshot::MappedSnapshot mapped) : m_snapshot(std::move(mapped)) {}
+
+    snapshot::MappedSnapshot m_snapshot;
+    const PackedImage* m_images{nullptr};
+};
+
+// Fork-join pool with one task deque per worker: a worker pops its own newest task (LIFO, still warm
+// in cache) and, when it runs dry, steals the oldest task of another queue (FIFO, usually the biggest
+// piece of work left). Threads outside the pool push to a shared queue and help while they wait.
+class WorkStealingPool {
+  public:
+    using Task = std::function<void()>;
+
+    // 'hardware_concurrency() - 1' workers: the thread that waits on a 'TaskGroup' is the last one.
+    static WorkStealingPool& Instance() {
+      static WorkStealingPool pool(std::max(1U, std::thread::hardware_concurrency()) - 1);
+      return pool;
+    }
+
+    // Tasks run through a group; 'Wait' keeps running queued tasks until all of the group's are done,
+    // so nested fork-join (a task that forks and waits for its own children) cannot deadlock.
+    class TaskGroup {
+      public:
+        explicit TaskGroup(WorkStealingPool& pool = Instance()) : m_pool(pool) {}
+        TaskGroup(const TaskGroup&) = delete;
+        TaskGroup& operator=(const TaskGroup&) = delete;
+        ~TaskGroup() { Wait(); }
+
+        void Run(Task task) {
+          m_pending.fetch_add(1, std::memory_order_relaxed);
+          m_pool.Push([this, task = std::move(task)] {
+            task();
+            m_pending.fetch_sub(1, std::memory_order_release);
+          });
+        }
+
+        void Wait() {
+          while (m_pending.load(std::memory_order_acquire) != 0) {
+            if (!m_pool.RunOne()) std::this_thread::yield();
+          }
+        }
+
+      private:
+        WorkStealingPool& m_pool;
+        std::atomic<std::size_t> m_pending{0};
+    };
+
+    WorkStealingPool(const WorkStealingPool&) = delete;
+    WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+    ~WorkStealingPool() {
+      {
+        std::lock_guard<std::mutex> lock(m_wake_mutex);
+        m_stopping = true;
+      }
+      m_wake.notify_all();
+      for (std::thread& thread : m_threads) thread.join();
+    }
+
+  private:
+    struct Queue {
+      std::mutex mutex;
+      std::deque<Task> tasks;
+    };
+
+    explicit WorkStealingPool(std::size_t workers) {
+      m_queues.reserve(workers + 1);
+      for (std::size_t i{0}; i <= workers; ++i) { // The last queue is shared by outside threads
+        m_queues.push_back(std::make_unique<Queue>());
+      }
+
+      m_threads.reserve(workers);
+      for (std::size_t i{0}; i < workers; ++i) {
+        m_threads.emplace_back([this, i] { WorkerLoop(i); });
+      }
+    }
+
+    static std::size_t& HomeQueue() {
+      thread_local std::size_t home{std::numeric_limits<std::size_t>::max()}; // Not a worker
+      return home;
+    }
+
+    std::size_t HomeIndex() const { return std::min(HomeQueue(), m_queues.size() - 1); }
+
+    void Push(Task task) {
+      Queue& queue{*m_queues[HomeIndex()]};
+      {
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        queue.tasks.push_back(std::move(task));
+      }
+      m_queued.fetch_add(1, std::memory_order_release);
+
+      // Taking the mutex orders this with a worker's predicate check, so the wake-up cannot be lost.
+      { std::lock_guard<std::mutex> lock(m_wake_mutex); }
+      m_wake.notify_one();
+    }
+
+    bool RunOne() {
+      const std::size_t home{HomeIndex()};
+      Task task;
+
+      for (std::size_t k{0}; k < m_queues.size() && !task; ++k) {
+        Queue& queue{*m_queues[(home + k) % m_queues.size()]};
+        std::lock_guard<std::mutex> lock(queue.mutex);
+        if (queue.tasks.empty()) continue;
+
+        if (k == 0) { // Own queue: newest first
+          task = std::move(queue.tasks.back());
+          queue.tasks.pop_back();
+        } else { // Steal: oldest first
+          task = std::move(queue.tasks.front());
+          queue.tasks.pop_front();
+        }
+      }
+
+      if (!task) return false;
+      m_queued.fetch_sub(1, std::memory_order_relaxed);
+      task();
+      return true;
+    }
+
+    void WorkerLoop(std::size_t index) {
+      HomeQueue() = index;
+      for (;;) {
+        if (RunOne()) continue;
+
+        std::unique_lock<std::mutex> lock(m_wake_mutex);
+        m_wake.wait(lock, [this] { return m_stopping || m_queued.load(std::memory_order_acquire) > 0; });
+        if (m_stopping && m_queued.load(std::memory_order_acquire) == 0) return;
+      }
+    }
+
+    std::vector<std::unique_ptr<Queue>> m_queues;
+    std::vector<std::thread> m_threads;
+    std::atomic<std::size_t> m_queued{0};
+    std::mutex m_wake_mutex;
+    std::condition_variable m_wake;
+    bool m_stopping{false};
+};
+
+// Runs 'body(begin, end)' over [0, count) in chunks of at least 'grain' on the pool.
+template<typename Body>
+void ParallelFor(std::size_t count, std::size_t grain, const Body& body) {
+  WorkStealingPool::TaskGroup group;
+  std::size_t begin{0};
+  for (; begin + 2 * grain <= count; begin += grain) {
+    group.Run([&body, begin, grain] { body(begin, begin + grain); });
+  }
+  body(begin, count); // The calling thread takes the last chunk
+  group.Wait();
+}
+
+constexpr std::size_t kParallelSortCutoff{1 << 14}; // Ranges below this are sorted/merged serially
+
+// Splits the larger run at its middle key, places that key, and merges the two sides in parallel.
+// The keys are unique (the index is part of them), so which run comes first does not matter.
+void ParallelMerge(const std::uint64_t* a, std::size_t a_size, const std::uint64_t* b, std::size_t b_size, std::uint64_t* out) {
+  if (a_size + b_size <= kParallelSortCutoff) {
+    std::merge(a, a + a_size, b, b + b_size, out);
+    return;
+  }
+  if (a_size < b_size) {
+    std::swap(a, b);
+    std::swap(a_size, b_size);
+  }
+
+  const std::size_t i{a_size / 2};
+  const auto j = static_cast<std::size_t>(std::lower_bound(b, b + b_size, a[i]) - b);
+  out[i + j] = a[i];
+
+  WorkStealingPool::TaskGroup group;
+  group.Run([=] { ParallelMerge(a, i, b, j, out); });
+  ParallelMerge(a + i + 1, a_size - i - 1, b + j, b_size - j, out + i + j + 1);
+  group.Wait();
+}
+
+// Merge sort of 'keys[0, count)' that ping-pongs between 'keys' and 'scratch' instead of copying back
+// after every merge; the result ends up in 'scratch' if 'into_scratch', else in 'keys'.
+void ParallelMergeSort(std::uint64_t* keys, std::uint64_t* scratch, std::size_t count, bool into_scratch) {
+  if (count <= kParallelSortCutoff) {
+    std::sort(keys, keys + count);
+    if (into_scratch) std::copy(keys, keys + count, scratch);
+    return;
+  }
+
+  const std::size_t half{count / 2};
+  {
+    WorkStealingPool::TaskGroup group;
+    group.Run([=] { ParallelMergeSort(keys, scratch, half, !into_scratch); });
+    ParallelMergeSort(keys + half, scratch + half, count - half, !into_scratch);
+  }
+
+  const std::uint64_t* from{into_scratch ? keys : scratch};
+  ParallelMerge(from, half, from + half, count - half, into_scratch ? scratch : keys);
+}
+
+enum class SortPolicy {
+  Sequential,
+  Parallel // 'std::execution::par_unseq' when 'SUPPORTS_PARALLEL_STL', else the in-house merge sort
+};
+
+// Parallel backend: keys are built, sorted and applied in parallel. Sorting (size, index) keys is always
+// stable, because no two keys are equal.
+void ParallelSortBySize(std::vector<Image>& images, SortOrder order) {
+  constexpr std::size_t kGrain{1 << 16};
+  const std::size_t count{images.size()};
+  std::vector<std::uint64_t> keys(count);
+
+  ParallelFor(count, kGrain, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i{begin}; i < end; ++i) {
+      std::uint32_t size{ComputeSizeKey(images[i].GetWidth(), images[i].GetHeight(), images[i].GetColorDepth())};
+      if (order == SortOrder::Descending) size = ~size;
+      keys[i] = (static_cast<std::uint64_t>(size) << 32) | static_cast<std::uint32_t>(i);
+    }
+  });
+
+  #if SUPPORTS_PARALLEL_STL
+    std::sort(std::execution::par_unseq, keys.begin(), keys.end());
+  #else
+    std::vector<std::uint64_t> scratch(count);
+    ParallelMergeSort(keys.data(), scratch.data(), count, false);
+  #endif // SUPPORTS_PARALLEL_STL
+
+  std::vector<Image> sorted(images);
+  ParallelFor(count, kGrain, [&](std::size_t begin, std::size_t end) {
+    for (std::size_t i{begin}; i < end; ++i) {
+      sorted[i] = images[static_cast<std::uint32_t>(keys[i])];
+    }
+  });
+  images.swap(sorted);
+}
+
+// Shared by the four entry points below: big inputs go to a key-based (and so stable) backend, small
+// ones to 'std::sort', or 'std::stable_sort' when the caller asked for stability.
+std::vector<Image>& SortBySize(std::vector<Image>& images, SortOrder order, SortPolicy policy, bool stable) {
+  TRACE_SCOPE("SortBySize");
+  if (images.size() > std::numeric_limits<std::uint32_t>::max()) {
+    std::stable_sort(images.begin(), images.end(), order == SortOrder::Ascending ? CompareAscending : CompareDescending);
+    return images;
+  }
+
+  if (policy == SortPolicy::Parallel && images.size() >= kParallelSortCutoff) {
+    ParallelSortBySize(images, order);
+  } else if (images.size() >= Config::RADIX_SORT_MIN_IMAGES) {
+    RadixSort(images, order);
+  } else if (stable) {
+    std::stable_sort(images.begin(), images.end(), order == SortOrder::Ascending ? CompareAscending : CompareDescending);
+  } else {
+    std::sort(images.begin(), images.end(), order == SortOrder::Ascending ? CompareAscending : CompareDescending);
+    // Alternatively with lambdas: [](const Image& a, const Image& b) { ... }
+  }
   return images;
 }
 
-std::vector<Image> ReverseSort(std::vector<Image>& images) {
-  std::sort(images.begin(), images.end(), CompareDescending);
+// Sorting is in place, so return the same vector by reference instead of a full copy.
+std::vector<Image>& Sort(std::vector<Image>& images, SortPolicy policy = SortPolicy::Sequential) {
+  return SortBySize(images, SortOrder::Ascending, policy, false);
+}
+
+std::vector<Image>& ReverseSort(std::vector<Image>& images, SortPolicy policy = SortPolicy::Sequential) {
+  return SortBySize(images, SortOrder::Descending, policy, false);
+}
+
+// Images of equal size keep their insertion order.
+std::vector<Image>& StableSort(std::vector<Image>& images, SortPolicy policy = SortPolicy::Sequential) {
+  return SortBySize(images, SortOrder::Ascending, policy, true);
+}
+
+std::vector<Image>& StableReverseSort(std::vector<Image>& images, SortPolicy policy = SortPolicy::Sequential) {
+  return SortBySize(images, SortOrder::Descending, policy, true);
+}
+
+// Non-owning view over a contiguous run of images (what 'std::span<const Image>' is in C++20).
+struct ImageView {
+  const Image* first{nullptr};
+  std::size_t count{0};
+
+  const Image* begin() const noexcept { return first; }
+  const Image* end() const noexcept { return first + count; }
+  std::size_t size() const noexcept { return count; }
+  const Image& operator[](std::size_t index) const noexcept { return first[index]; }
+};
+
+// Top-K / bottom-K queries. When only the N largest or smallest images are needed, a full sort is
+// wasted work: the in-place versions use 'std::partial_sort' (O(n log k)) and return a view of the
+// first 'k' elements, ordered; the rest of the vector is left in unspecified order.
+ImageView LargestK(std::vector<Image>& images, std::size_t k) {
+  k = std::min(k, images.size());
+  std::partial_sort(images.begin(), images.begin() + k, images.end(), CompareDescending);
+  return ImageView{images.data(), k};
+}
+
+ImageView SmallestK(std::vector<Image>& images, std::size_t k) {
+  k = std::min(k, images.size());
+  std::partial_sort(images.begin(), images.begin() + k, images.end(), CompareAscending);
+  return ImageView{images.data(), k};
+}
+
+// Bounded heap of the best 'k' (size, index) pairs seen so far; the root is the worst one kept, so
+// each image costs one compare against it and only a better one pays the O(log k) heap update.
+template<typename Better>
+std::vector<std::size_t> SelectKIndices(const std::vector<Image>& images, std::size_t k, Better better) {
+  using Entry = std::pair<unsigned long int, std::size_t>; // (size, index)
+  k = std::min(k, images.size());
+
+  // 'better' on sizes, lower index first on ties, so the result is deterministic.
+  auto Precedes = [better](const Entry& a, const Entry& b) {
+    return better(a.first, b.first) || (a.first == b.first && a.second < b.second);
+  };
+
+  std::vector<Entry> heap;
+  heap.reserve(k);
+  for (std::size_t i{0}; i < images.size() && k > 0; ++i) {
+    const Entry entry{images[i].GetSize(), i};
+    if (heap.size() < k) {
+      heap.push_back(entry);
+      std::push_heap(heap.begin(), heap.end(), Precedes);
+    } else if (Precedes(entry, heap.front())) {
+      std::pop_heap(heap.begin(), heap.end(), Precedes);
+      heap.back() = entry;
+      std::push_heap(heap.begin(), heap.end(), Precedes);
+    }
+  }
+
+  std::sort_heap(heap.begin(), heap.end(), Precedes); // Best first
+
+  std::vector<std::size_t> indices;
+  indices.reserve(heap.size());
+  for (const Entry& entry : heap) {
+    indices.push_back(entry.second);
+  }
+  return indices;
+}
+
+// Read-only versions: indices into 'images' of the 'k' largest (largest first) or smallest (smallest first).
+std::vector<std::size_t> LargestKIndices(const std::vector<Image>& images, std::size_t k) {
+  return SelectKIndices(images, k, [](unsigned long int a, unsigned long int b) { return a > b; });
+}
+
+std::vector<std::size_t> SmallestKIndices(const std::vector<Image>& images, std::size_t k) {
+  return SelectKIndices(images, k, [](unsigned long int a, unsigned long int b) { return a < b; });
+}
+
+// Inclusive [min, max] bound for one 'ImageQuery' field.
+template<typename T>
+struct ValueRange {
+  T min{std::numeric_limits<T>::min()};
+  T max{std::numeric_limits<T>::max()};
+
+  bool Contains(T value) const noexcept { return min <= value && value <= max; }
+};
+
+// Conjunction of optional predicates; an empty optional matches every image.
+// E.g. "width >= 1920 and depth 24": 'ImageQuery{ValueRange<std::uint16_t>{1'920}, {}, ValueRange<std::uint8_t>{24, 24}}'.
+struct ImageQuery {
+  std::optional<ValueRange<std::uint16_t>> width;
+  std::optional<ValueRange<std::uint16_t>> height;
+  std::optional<ValueRange<std::uint8_t>> color_depth;
+  std::optional<ValueRange<std::uint32_t>> size;
+
+  bool Matches(const Image& image) const {
+    return (!width || width->Contains(image.GetWidth())) && (!height || height->Contains(image.GetHeight()))
+        && (!color_depth || color_depth->Contains(image.GetColorDepth())) && (!size || size->Contains(image.GetSize()));
+  }
+};
+
+// Image catalog with secondary indexes, kept up to date on 'Insert' and 'SetColorDepth':
+// - color depth: one bitmap per value ('ValidateParameters' allows only 66 of them), plus exact counts;
+// - width, height, size: ordered sets of (key << 32 | id), the same key layout as the sort engine.
+// A query drives from the index with the fewest candidates and checks the remaining predicates on the
+// record itself. The depth path ORs the requested bitmaps, so it costs O(N/64) words plus its matches;
+// a range path costs O(log N) plus its matches, and the range sizes are only counted up to the best
+// candidate so far. The three sets take about 120 bytes per image (a tree node each), on top of the
+// record and its bitmap bit. Ids are insertion positions (at most 2^32 images) and results come back ascending.
+class ImageIndex {
+  public:
+    using Id = std::uint32_t;
+
+    // Throws 'std::length_error' once every 'Id' is taken.
+    Id Insert(const Image& image) {
+      if (m_images.size() > std::numeric_limits<Id>::max()) {
+        throw std::length_error("Error: The image index is full (ids are 32-bit).\n");
+      }
+      const auto id = static_cast<Id>(m_images.size());
+      m_images.push_back(image);
+      m_by_width.insert(Key(image.GetWidth(), id));
+      m_by_height.insert(Key(image.GetHeight(), id));
+      m_by_size.insert(Key(image.GetSize(), id));
+      SetDepthBit(image.GetColorDepth(), id);
+      return id;
+    }
+
+    // Validated by 'Image::SetColorDepth'; an invalid depth leaves the image and the indexes unchanged.
+    void SetColorDepth(Id id, std::uint8_t color_depth) {
+      Image& image{m_images.at(id)};
+      const std::uint8_t old_depth{image.GetColorDepth()};
+      const auto old_size = static_cast<std::uint32_t>(image.GetSize());
+
+      image.SetColorDepth(color_depth);
+      if (image.GetColorDepth() == old_depth) return;
+
+      ClearDepthBit(old_depth, id);
+      SetDepthBit(image.GetColorDepth(), id);
+      m_by_size.erase(Key(old_size, id));
+      m_by_size.insert(Key(image.GetSize(), id));
+    }
+
+    std::vector<Id> Find(const ImageQuery& query) const {
+      std::vector<Id> ids;
+      ForEachMatch(query, [&ids](Id id) { ids.push_back(id); });
+      return ids;
+    }
+
+    std::size_t Count(const ImageQuery& query) const {
+      if (query.color_depth && !query.width && !query.height && !query.size) { // Answered by the counts alone
+        return DepthCount(*query.color_depth);
+      }
+
+      std::size_t count{0};
+      ForEachMatch(query, [&count](Id) { ++count; });
+      return count;
+    }
+
+  // Getters
+    const Image& At(Id id) const {
+      return m_images.at(id);
+    }
+
+    std::size_t Size() const {
+      return m_images.size();
+    }
+
+  private:
+    using Word = std::uint64_t;
+    static constexpr std::size_t kWordBits{64};
+    static constexpr std::size_t kDepthValues{129}; // Indexed by depth, 1..128
+
+    static std::uint64_t Key(std::uint32_t value, Id id) {
+      return static_cast<std::uint64_t>(value) << 32 | id;
+    }
+
+    static unsigned CountTrailingZeros(Word word) noexcept { // 'word' must not be 0
+      #if defined(__GNUC__) || defined(__clang__)
+        return static_cast<unsigned>(__builtin_ctzll(word));
+      #else
+        unsigned count{0};
+        for (; (word & 1) == 0; word >>= 1) ++count;
+        return count;
+      #endif
+    }
+
+    void SetDepthBit(std::uint8_t depth, Id id) {
+      std::vector<Word>& bitmap{m_depth_bitmaps[depth]};
+      if (bitmap.size() <= id / kWordBits) bitmap.resize(id / kWordBits + 1, 0);
+      bitmap[id / kWordBits] |= Word{1} << (id % kWordBits);
+      ++m_depth_counts[depth];
+    }
+
+    void ClearDepthBit(std::uint8_t depth, Id id) {
+      m_depth_bitmaps[depth][id / kWordBits] &= ~(Word{1} << (id % kWordBits));
+      --m_depth_counts[depth];
+    }
+
+    std::size_t DepthCount(const ValueRange<std::uint8_t>& range) const {
+      std::size_t count{0};
+      for (unsigned depth{range.min}; depth <= range.max && depth < kDepthValues; ++depth) {
+        count += m_depth_counts[depth];
+      }
+      return count;
+    }
+
+    // Ordered-set entries with a key in [min, max], as an iterator pair.
+    struct Range {
+      std::set<std::uint64_t>::const_iterator first;
+      std::set<std::uint64_t>::const_iterator last;
+    };
+
+    static Range RangeOf(const std::set<std::uint64_t>& index, std::uint32_t min, std::uint32_t max) {
+      if (min > max) return {index.end(), index.end()}; // Empty range; 'lower_bound' would land past 'upper_bound'
+      return {index.lower_bound(Key(min, 0)), index.upper_bound(Key(max, std::numeric_limits<Id>::max()))};
+    }
+
+    // Size of 'range', counted no further than 'limit' (sets have no O(1) rank).
+    static std::size_t CountUpTo(Range range, std::size_t limit) {
+      std::size_t count{0};
+      for (; range.first != range.last && count < limit; ++range.first) ++count;
+      return count;
+    }
+
+    template<typename Visit>
+    void ForEachMatch(const ImageQuery& query, const Visit& visit) const {
+      const auto check = [&](Id id) { if (query.Matches(m_images[id])) visit(id); };
+      const std::size_t word_count{(m_images.size() + kWordBits - 1) / kWordBits};
+
+      // Pick the cheapest driver: a full scan, the depth bitmaps, or the smallest constrained range.
+      std::size_t best_cost{m_images.size()};
+      bool use_depth{false};
+      std::optional<Range> best_range;
+
+      if (query.color_depth) {
+        const std::size_t cost{word_count + DepthCount(*query.color_depth)};
+        if (cost < best_cost) {
+          best_cost = cost;
+          use_depth = true;
+        }
+      }
+
+      const auto consider = [&](const std::set<std::uint64_t>& index, const auto& range) {
+        if (!range) return;
+        const Range candidate{RangeOf(index, range->min, range->max)};
+        const std::size_t cost{CountUpTo(candidate, best_cost)};
+        if (cost < best_cost) {
+          best_cost = cost;
+          use_depth = false;
+          best_range = candidate;
+        }
+      };
+      consider(m_by_width, query.width);
+      consider(m_by_height, query.height);
+      consider(m_by_size, query.size);
+
+      if (best_range) {
+        std::vector<Id> ids;
+        ids.reserve(best_cost);
+        for (auto it = best_range->first; it != best_range->last; ++it) {
+          const auto id = static_cast<Id>(*it);
+          if (query.Matches(m_images[id])) ids.push_back(id);
+        }
+        std::sort(ids.begin(), ids.end()); // Range walks come back in key order
+        for (Id id : ids) visit(id);
+      } else if (use_depth) {
+        // OR the bitmaps of the requested depths, then walk the set bits (already in id order).
+        std::vector<Word> words(word_count, 0);
+        for (unsigned depth{query.color_depth->min}; depth <= query.color_depth->max && depth < kDepthValues; ++depth) {
+          const std::vector<Word>& bitmap{m_depth_bitmaps[depth]};
+          for (std::size_t i{0}; i < bitmap.size(); ++i) words[i] |= bitmap[i];
+        }
+        for (std::size_t i{0}; i < words.size(); ++i) {
+          for (Word word{words[i]}; word != 0; word &= word - 1) {
+            check(static_cast<Id>(i * kWordBits + CountTrailingZeros(word)));
+          }
+        }
+      } else {
+        for (std::size_t id{0}; id < m_images.size(); ++id) check(static_cast<Id>(id));
+      }
+    }
+
+    std::vector<Image> m_images;
+    std::set<std::uint64_t> m_by_width;
+    std::set<std::uint64_t> m_by_height;
+    std::set<std::uint64_t> m_by_size;
+    std::array<std::vector<Word>, kDepthValues> m_depth_bitmaps;
+    std::array<std::size_t, kDepthValues> m_depth_counts{};
+};
+
+// Works for any range of elements with a 'WriteRecord' ('std::vector', 'ImageView', ...); the whole
+// listing is formatted into one buffer and written at once.
+template <typename Range>
+void PrintVector(const Range& range, const std::string& text) {
+  output::Writer out{stdout};
+  out << text << '\n';
+  for (const auto& element : range) {
+    WriteRecord(out, element);
+  }
+}
+
+template<typename Number>
+std::optional<Number> ParseNumber(std::string_view field) {
+  Number value{};
+  const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+  if (error != std::errc() || end != field.data() + field.size()) return std::nullopt;
+  return value;
+}
+
+// One image per line, 'width,height,color_depth'. Malformed lines and images 'ValidateParameters'
+// rejects are reported by line number and skipped, instead of taking the constructor's fallback.
+static std::vector<Image> ParseImages(std::string_view text, std::size_t& skipped) {
+  std::vector<Image> images;
+  std::size_t line_number{0};
+
+  while (!text.empty()) {
+    const std::size_t newline{text.find('\n')};
+    std::string_view line{input::Trim(text.substr(0, newline))};
+    text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+    ++line_number;
+    if (line.empty()) continue;
+
+    std::string_view fields[3];
+    std::size_t count{0};
+    for (; count < 3 && !line.empty(); ++count) {
+      const std::size_t comma{line.find(',')};
+      fields[count] = input::Trim(line.substr(0, comma));
+      line.remove_prefix(comma == std::string_view::npos ? line.size() : comma + 1);
+    }
+
+    const auto width = count == 3 && line.empty() ? ParseNumber<std::uint16_t>(fields[0]) : std::nullopt;
+    const auto height = ParseNumber<std::uint16_t>(fields[1]);
+    const auto color_depth = ParseNumber<std::uint8_t>(fields[2]);
+    if (!width || !height || !color_depth) {
+      ++skipped;
+      std::cerr << "Line " << line_number << ": expected 'width,height,color_depth'; skipped.\n";
+      continue;
+    }
+
+    try {
+      Image::ValidateParameters(*width, *height, *color_depth);
+    } catch (const std::invalid_argument& e) {
+      ++skipped;
+      std::cerr << "Line " << line_number << ": " << e.what();
+      continue;
+    }
+    images.emplace_back(*width, *height, *color_depth);
+  }
+
   return images;
 }
 
-template <typename T>
-void PrintVector(const std::vector<T>& vector, const std::string& text) {
-  std::cout << text << '\n';
-  for (const T& element : vector) {
-    std::cout << element << '\n';
+// Usage: run.exe --save-snapshot <snapshot> [file|-] - reads images from 'file' (or standard input) and saves
+// them twice for '--load-snapshot': sorted by size as a 'PackedImageStore' in '<snapshot>', and in input order
+// as 'ImageColumns' in '<snapshot>.columns'.
+static int RunSaveSnapshotMode(const std::string& snapshot_path, const char* path) {
+  std::FILE* stream{path ? std::fopen(path, "rb") : stdin};
+  if (!stream) {
+    std::cerr << "Error: Cannot open '" << path << "'.\n";
+    return EXIT_FAILURE;
+  }
+
+  const std::string text{input::ReadAll(stream)};
+  if (path) std::fclose(stream);
+
+  std::size_t skipped{0};
+  const std::vector<Image> images{ParseImages(text, skipped)};
+  PackedImageStore packed{PackedImageStore::From(images)};
+  packed.Sort();
+
+  const std::string columns_path{snapshot_path + ".columns"};
+  std::error_code error{packed.SaveSnapshot(snapshot_path)};
+  if (error) {
+    std::cerr << "Error: Cannot write '" << snapshot_path << "': " << error.message() << '\n';
+    return EXIT_FAILURE;
+  }
+  if ((error = ImageColumns::From(images).SaveSnapshot(columns_path))) {
+    std::cerr << "Error: Cannot write '" << columns_path << "': " << error.message() << '\n';
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Saved " << images.size() << " images to '" << snapshot_path << "' (skipped lines: " << skipped << ")\n";
+  return skipped ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// Usage: run.exe --load-snapshot <snapshot> - maps both files of '--save-snapshot' and prints the images in
+// ascending order (from the packed records) and the capacity report (from the columns).
+static int RunLoadSnapshotMode(const std::string& snapshot_path) {
+  const std::string columns_path{snapshot_path + ".columns"};
+  auto opened_packed = PackedImageView::Open(snapshot_path);
+  if (const auto* error = std::get_if<std::error_code>(&opened_packed)) {
+    std::cerr << "Error: Cannot load '" << snapshot_path << "': " << error->message() << '\n';
+    return EXIT_FAILURE;
   }
+  auto opened_columns = ImageColumnsView::Open(columns_path);
+  if (const auto* error = std::get_if<std::error_code>(&opened_columns)) {
+    std::cerr << "Error: Cannot load '" << columns_path << "': " << error->message() << '\n';
+    return EXIT_FAILURE;
+  }
+  const PackedImageView& packed{std::get<PackedImageView>(opened_packed)};
+
+  {
+    output::Writer out{stdout};
+    out << "Ascending Order:\n";
+    for (std::size_t i{0}; i < packed.Size(); ++i) {
+      WriteRecord(out, packed.At(i));
+    }
+    out << '\n';
+  } // Flushed here, before the report's own writer
+
+  PrintCapacityReport(BuildCapacityReport(std::get<ImageColumnsView>(opened_columns)));
+  return EXIT_SUCCESS;
 }
 
+#if BENCHMARK_ENABLED
+// Usage: run.exe --benchmark [max_images] - 'std::sort', 'RadixSort', 'Sort'/'ReverseSort', the parallel backend
+// and 'PackedImageStore::Sort' on random valid images, then saving and mapping back snapshots of the stores, from
+// 1K up to 'max_images' (1K, 10K, ...; default 100M, which needs ~3 GB). Every backend's output is checked
+// against 'std::sort', 'reduce::argmax' on the sizes against 'LargestKIndices', and every snapshot's footprint
+// (and the capacity report's total) against the store it was saved from.
+static int RunSortBenchmark(std::size_t max_images) {
+  constexpr std::uint8_t kDepths[]{1, 2, 3, 4, 8, 16, 24, 30, 36, 48, 64, 96, 128};
+  bench::Generator generator;
+  bench::PrintHeader();
+
+  for (std::size_t count : bench::Scales(max_images)) {
+    std::vector<Image> images;
+    images.reserve(count);
+    for (std::size_t i{0}; i < count; ++i) {
+      const auto width = static_cast<std::uint16_t>(2 * generator.Uniform(20, 3'840));  // Even, 40..7,680
+      const auto height = static_cast<std::uint16_t>(2 * generator.Uniform(13, 2'160)); // Even, 26..4,320
+      images.emplace_back(width, height, generator.Pick(kDepths));
+    }
+
+    std::vector<Image> sorted;
+    const auto restore = [&] { sorted = images; };
+    const auto same_size = [](const Image& a, const Image& b) { return a.GetSize() == b.GetSize(); };
+
+    bench::Run("std::sort", count, restore, [&] { std::sort(sorted.begin(), sorted.end(), CompareAscending); });
+    const std::vector<Image> expected{sorted};
+
+    bool same{true};
+    bench::Run("RadixSort", count, restore, [&] { RadixSort(sorted); });
+    same = same && std::equal(expected.begin(), expected.end(), sorted.begin(), same_size);
+    bench::Run("Sort", count, restore, [&] { Sort(sorted); });
+    same = same && std::equal(expected.begin(), expected.end(), sorted.begin(), same_size);
+    bench::Run("ReverseSort", count, restore, [&] { ReverseSort(sorted); });
+    same = same && std::equal(expected.rbegin(), expected.rend(), sorted.begin(), same_size);
+    bench::Run("Sort (parallel)", count, restore, [&] { Sort(sorted, SortPolicy::Parallel); });
+    same = same && std::equal(expected.begin(), expected.end(), sorted.begin(), same_size);
+
+    PackedImageStore packed;
+    bench::Run("PackedImageStore::Sort", count, [&] { packed = PackedImageStore::From(images); }, [&] { packed.Sort(); });
+    same = same && std::equal(expected.begin(), expected.end(), packed.Records().begin(),
+                              [](const Image& a, PackedImage b) { return a.GetSize() == b.GetSize(); });
+
+    if (!same) {
+      std::cerr << "Error: the sort backends disagree at " << count << " images.\n";
+      return EXIT_FAILURE;
+    }
+
+    // Only the largest image: one pass over the size column instead of a sort or a heap.
+    const std::vector<std::uint32_t> sizes{ComputeSizes(images)};
+    std::size_t largest{0};
+    bench::Run("reduce::argmax (sizes)", count, [&] { largest = reduce::argmax(sizes); });
+    if (largest != LargestKIndices(images, 1).front()) {
+      std::cerr << "Error: the largest image disagrees at " << count << " images.\n";
+      return EXIT_FAILURE;
+    }
+
+    // Restart: the sorted records and the catalog columns saved once, then mapped back.
+    const std::string packed_path{bench::TemporaryPath("images.snapshot")};
+    bench::Run("PackedImageStore::SaveSnapshot", count, [&] { bench::DoNotOptimize(packed.SaveSnapshot(packed_path)); });
+    bench::Run("PackedImageView::Open", count, [&] { bench::DoNotOptimize(PackedImageView::Open(packed_path).index()); });
+    auto opened_packed = PackedImageView::Open(packed_path);
+    const PackedImageView* packed_view{std::get_if<PackedImageView>(&opened_packed)};
+    std::uint64_t packed_footprint{0};
+    if (packed_view) bench::Run("PackedImageView::TotalFootprint", count, [&] { packed_footprint = packed_view->TotalFootprint(); });
+
+    const ImageColumns columns{ImageColumns::From(images)};
+    const std::string columns_path{bench::TemporaryPath("image-columns.snapshot")};
+    bench::Run("ImageColumns::SaveSnapshot", count, [&] { bench::DoNotOptimize(columns.SaveSnapshot(columns_path)); });
+    auto opened_columns = ImageColumnsView::Open(columns_path);
+    const ImageColumnsView* columns_view{std::get_if<ImageColumnsView>(&opened_columns)};
+    std::uint64_t columns_footprint{0};
+    if (columns_view) bench::Run("TotalFootprint (ImageColumnsView)", count, [&] { columns_footprint = TotalFootprint(*columns_view); });
+    CapacityReport report;
+    bench::Run("BuildCapacityReport", count, [&] { report = BuildCapacityReport(columns); });
+
+    std::error_code ignored;
+    std::filesystem::remove(packed_path, ignored);
+    std::filesystem::remove(columns_path, ignored);
+
+    const std::uint64_t footprint{packed.TotalFootprint()};
+    if (packed_footprint != footprint || columns_footprint != footprint || report.total_footprint != footprint) {
+      std::cerr << "Error: the snapshots disagree at " << count << " images (" << footprint << ", " << packed_footprint
+                << ", " << columns_footprint << ", " << report.total_footprint << ").\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+#endif // BENCHMARK_ENABLED
+
+
+int main(int argc, char* argv[]) {
+  if (argc > 2 && std::string_view(argv[1]) == "--save-snapshot") {
+    return RunSaveSnapshotMode(argv[2], argc > 3 && std::string_view(argv[3]) != "-" ? argv[3] : nullptr);
+  }
+
+  if (argc > 2 && std::string_view(argv[1]) == "--load-snapshot") {
+    return RunLoadSnapshotMode(argv[2]);
+  }
+
+  if (argc > 1 && std::string_view(argv[1]) == "--benchmark") {
+    #if BENCHMARK_ENABLED
+      return RunSortBenchmark(bench::ParseCount(argc > 2 ? argv[2] : nullptr, 100'000'000));
+    #else
+      std::cerr << "Error: '--benchmark' needs a build with -DENABLE_BENCHMARK.\n";
+      return EXIT_FAILURE;
+    #endif // BENCHMARK_ENABLED
+  }
 
-int main() {
   std::vector<Image> images;
   images.reserve(kImages);
 
@@ -161,5 +1432,9 @@ int main() {
   Sort(images);
   PrintVector(images, "Ascending Order:");
 
+  std::cout << '\n';
+
+  PrintCapacityReport(BuildCapacityReport(ImageColumns::From(images)));
+
   return 0;
 }
@@ -6,44 +6,197 @@
 #include <cstdint> // More specific data types (for optimization)
 #include <string>
 #include <memory> // Unique pointers
+#include <string_view>
+#include <optional>
+#include <vector>
+#include <limits>
+#include <charconv> // 'std::from_chars' for the bulk input mode
+#include <cstdio>
+#include <cstdlib>
+#include <system_error>
+#include <algorithm>
+#include <new> // Placement new and 'std::launder' for the slab pools
+#include <memory_resource> // Owner names allocated from the arena in 'FleetArena'
+#include <type_traits>
+#include <unordered_map>
+#include <functional>
+#include <array>
+#include <variant>
+#include <filesystem>
+#include <utility>
+#define NOMINMAX // Otherwise the 'min'/'max' macros of 'windows.h' break 'std::min' and 'numeric_limits<T>::max()'
 #include <windows.h> // UTF-8 (supports greek language and the euro sign)
+#include "../common/trace.h" // Lifecycle events and timings; compiled out unless -DENABLE_TRACING
+#include "../common/bench.h" // '--benchmark' harness and data generators; compiled out unless -DENABLE_BENCHMARK
+#include "../common/output.h" // Buffered text/CSV/binary reports
+#include "../common/input.h" // Whole-stream reads for the bulk input mode
+#include "../common/snapshot.h" // Binary snapshots loaded by memory mapping
+#include "../common/reduce.h" // Reducers and the slicing of the parallel kernels
+
+#if __cplusplus >= 202002L
+  #include <span>
+  #define SUPPORTS_CPP20 1
+#else
+  #define SUPPORTS_CPP20 0
+#endif // __cplusplus
+
+// Compile with '-mavx2' (or '-march=native') to enable the vectorized tax kernels.
+#if defined(__AVX2__)
+  #include <immintrin.h>
+  #define SUPPORTS_AVX2 1
+#else
+  #define SUPPORTS_AVX2 0
+#endif // __AVX2__
 
 using RegistrationNumber = std::uint16_t;
 using EngineCC = std::uint16_t;
 using NumberOfDoors = std::uint8_t;
 using MaxTruckWeight = std::uint32_t;
 using Tax = std::uint32_t;
+using TotalTax = std::uint64_t; // Fleet totals exceed 'Tax'
 using NumberOfVehicles = std::uint8_t;
 
+enum class VehicleType : std::uint8_t {
+  Car = 1,
+  Truck = 2
+};
+
+// Truck surcharge for weights strictly above 'above'.
+struct TruckTier {
+  MaxTruckWeight above;
+  Tax surcharge;
+};
+
+// Tax rules of one year/region as a compile-time policy ('Config::TaxPolicy' picks the one in use):
+// the car formula, which is tabulated for every engine cc at compile time, and the truck weight tiers.
+struct StandardTaxPolicy {
+  static constexpr Tax CarTax(EngineCC engine_cc) {
+    return engine_cc <= 1'000 ? 140 : 140 + ((engine_cc - 1'000) / 100) * 10;
+  }
+
+  static constexpr Tax kTruckBaseTax{300};
+  static constexpr std::array<TruckTier, 2> kTruckTiers{{{3'000, 100}, {6'000, 200}}}; // 300 / 400 / 600
+};
+
 namespace Config {
   constexpr bool DEVELOPER_MODE{false};
-  constexpr bool CONFIDENTIAL_OVERRIDE{false};
+
+  // Smallest slice of a fleet worth handing to its own thread in 'CalculateTotalTaxParallel'.
+  constexpr std::size_t TAX_MIN_VEHICLES_PER_WORKER{1 << 16};
+
+  // Vehicles per slab in 'FleetArena': one allocation per this many cars (or trucks).
+  constexpr std::size_t FLEET_SLAB_VEHICLES{4'096};
+
+  // Tax rules used by every tax path; swap for another policy per year or region.
+  using TaxPolicy = StandardTaxPolicy;
 }
 
+// Car tax of every possible 'EngineCC' (64K entries, 128 KB), generated at compile time, so both the
+// single-vehicle and the batch paths do one load instead of a division.
+template<typename Policy>
+struct CarTaxTable {
+  using Entry = std::uint16_t;
+  static constexpr std::size_t kEntries{std::size_t{std::numeric_limits<EngineCC>::max()} + 1};
+
+  // One entry of padding: the AVX2 kernel gathers 4 bytes per lookup.
+  static constexpr std::array<Entry, kEntries + 1> kTaxes = [] {
+    std::array<Entry, kEntries + 1> taxes{};
+    for (std::size_t engine_cc{0}; engine_cc < kEntries; ++engine_cc) {
+      const Tax tax{Policy::CarTax(static_cast<EngineCC>(engine_cc))};
+      if (tax > std::numeric_limits<Entry>::max()) throw "Car tax does not fit the table"; // Fails the build
+      taxes[engine_cc] = static_cast<Entry>(tax);
+    }
+    return taxes;
+  }();
+};
+
+// Tax formulas, shared by the classes below and the batch kernels on 'FleetTable'.
+template<typename Policy = Config::TaxPolicy>
+constexpr Tax CarTrafficTax(EngineCC engine_cc) {
+  return CarTaxTable<Policy>::kTaxes[engine_cc];
+}
+
+// Branchless: one comparison per tier.
+template<typename Policy = Config::TaxPolicy>
+constexpr Tax TruckTrafficTax(MaxTruckWeight max_weight) {
+  Tax tax{Policy::kTruckBaseTax};
+  for (const TruckTier& tier : Policy::kTruckTiers) {
+    tax += tier.surcharge * Tax{max_weight > tier.above};
+  }
+  return tax;
+}
+
+static_assert(CarTrafficTax<StandardTaxPolicy>(1'000) == 140 && CarTrafficTax<StandardTaxPolicy>(1'550) == 190);
+static_assert(TruckTrafficTax<StandardTaxPolicy>(3'000) == 300 && TruckTrafficTax<StandardTaxPolicy>(6'001) == 600);
+
 class Vehicle {
   public:
-    Vehicle(RegistrationNumber registration_number, const std::string& owner_name, EngineCC engine_cc)
-        : m_registration_number(registration_number), m_owner_name(std::move(owner_name)), m_engine_cc(engine_cc) {
-          if constexpr (Config::DEVELOPER_MODE) {
-            std::cout << "Vehicle object created: " << *this << '\n';
-          }
+    // 'names' allocates the owner's name (past the small-string buffer); the default is plain 'new'/'delete'.
+    Vehicle(RegistrationNumber registration_number, std::string_view owner_name, EngineCC engine_cc,
+            std::pmr::memory_resource* names = std::pmr::get_default_resource())
+        : m_registration_number(registration_number), m_owner_name(owner_name, names), m_engine_cc(engine_cc) {
+          TRACE_OBJECT_CREATED("Vehicle", this);
     }
 
     virtual ~Vehicle() noexcept {
-      if constexpr (Config::DEVELOPER_MODE && Config::CONFIDENTIAL_OVERRIDE) {
-        std::cout << "Vehicle object created: " << *this << '\n';
-      }
+      TRACE_OBJECT_DESTROYED("Vehicle", this);
     }
 
     // Pure virtual function makes Vehicle abstract
     virtual Tax CalculateTrafficTax() const = 0;
+    virtual VehicleType GetType() const = 0;
     
-    static Tax CalculateTotalTax(const std::unique_ptr<Vehicle> vehicles[], std::size_t size, std::size_t index = 0) {
-      if (index == size) {
-        return 0;
+    // Iterative, so the fleet size is not limited by the stack (the recursive version used one frame per vehicle).
+    // 'VehiclePointer' is 'std::unique_ptr<Vehicle>' or 'Vehicle*' (e.g. 'FleetArena::Vehicles').
+    template<typename VehiclePointer>
+    static TotalTax CalculateTotalTax(const VehiclePointer vehicles[], std::size_t size) {
+      TotalTax total{0};
+      for (std::size_t i{0}; i < size; ++i) {
+        total += vehicles[i]->CalculateTrafficTax();
       }
+      return total;
+    }
+
+    // Same total, split across cores in contiguous slices (at least 'Config::TAX_MIN_VEHICLES_PER_WORKER' each).
+    template<typename VehiclePointer>
+    static TotalTax CalculateTotalTaxParallel(const VehiclePointer vehicles[], std::size_t size) {
+      TRACE_SCOPE("CalculateTotalTaxParallel");
+      const std::vector<TotalTax> partials{reduce::MapSlices<TotalTax>(size, Config::TAX_MIN_VEHICLES_PER_WORKER,
+          [vehicles](std::size_t begin, std::size_t end) { return CalculateTotalTax(vehicles + begin, end - begin); })};
+
+      TotalTax total{0};
+      for (TotalTax partial : partials) {
+        total += partial;
+      }
+      return total;
+    }
+
+    #if SUPPORTS_CPP20
+      static TotalTax CalculateTotalTax(std::span<const std::unique_ptr<Vehicle>> vehicles) {
+        return CalculateTotalTax(vehicles.data(), vehicles.size());
+      }
+
+      static TotalTax CalculateTotalTaxParallel(std::span<const std::unique_ptr<Vehicle>> vehicles) {
+        return CalculateTotalTaxParallel(vehicles.data(), vehicles.size());
+      }
+    #endif // SUPPORTS_CPP20
+
+  // Getters
+    RegistrationNumber GetRegistrationNumber() const {
+      return m_registration_number;
+    }
 
-      return vehicles[index]->CalculateTrafficTax() + CalculateTotalTax(vehicles, size, index + 1);
+    std::string_view GetOwnerName() const {
+      return m_owner_name;
+    }
+
+    EngineCC GetEngineCC() const {
+      return m_engine_cc;
+    }
+
+  // Setter
+    void SetEngineCC(EngineCC engine_cc) {
+      m_engine_cc = engine_cc;
     }
 
     friend std::ostream& operator<<(std::ostream& os, const Vehicle& vehicle) {
@@ -51,29 +204,50 @@ class Vehicle {
           << vehicle.m_owner_name<< ' ' << vehicle.m_engine_cc;
     }
 
+    // Bulk output: one summary line ('operator<<' and the tax), or one CSV/binary record
+    // 'type, registration_number, owner_name, engine_cc, tax' ('type' is the 'VehicleType' value in binary).
+    friend void WriteRecord(output::Writer& out, const Vehicle& vehicle, Tax tax) {
+      switch (out.GetFormat()) {
+        case output::Format::Text:
+          out << vehicle.m_registration_number << ' ' << vehicle.m_owner_name << ' ' << vehicle.m_engine_cc
+              << " - €" << tax << '\n';
+          break;
+        case output::Format::Csv:
+          out.Record(vehicle.GetType() == VehicleType::Car ? "car" : "truck", vehicle.m_registration_number,
+                     vehicle.m_owner_name, vehicle.m_engine_cc, tax);
+          break;
+        case output::Format::Binary:
+          out.Record(static_cast<std::uint8_t>(vehicle.GetType()), vehicle.m_registration_number,
+                     vehicle.m_owner_name, vehicle.m_engine_cc, tax);
+          break;
+      }
+    }
+
   protected:
     RegistrationNumber m_registration_number;
-    std::string m_owner_name;
+    std::pmr::string m_owner_name;
     EngineCC m_engine_cc;
 };
 
-class Car : public Vehicle {
+// 'final': a call through a 'Car' (not a 'Vehicle') reference can be resolved at compile time and inlined.
+class Car final : public Vehicle {
   public:
-    Car(RegistrationNumber registration_number, const std::string& owner_name, EngineCC engine_cc, NumberOfDoors number_of_doors)
-        : Vehicle(registration_number, std::move(owner_name), engine_cc), m_number_of_doors(number_of_doors) {
-          if constexpr (Config::DEVELOPER_MODE) {
-            std::cout << "Car object created: " << *this << '\n';
-          }
+    Car(RegistrationNumber registration_number, std::string_view owner_name, EngineCC engine_cc, NumberOfDoors number_of_doors,
+        std::pmr::memory_resource* names = std::pmr::get_default_resource())
+        : Vehicle(registration_number, owner_name, engine_cc, names), m_number_of_doors(number_of_doors) {
+          TRACE_OBJECT_CREATED("Car", this);
     }
 
     ~Car() noexcept override {
-      if constexpr (Config::DEVELOPER_MODE && Config::CONFIDENTIAL_OVERRIDE) {
-        std::cout << "Car object created: " << *this << '\n';
-      }
+      TRACE_OBJECT_DESTROYED("Car", this);
     }
 
     Tax CalculateTrafficTax() const override {
-      return (m_engine_cc <= 1'000 ? 140 : 140 + ((m_engine_cc - 1'000) / 100) * 10);
+      return CarTrafficTax(m_engine_cc);
+    }
+
+    VehicleType GetType() const override {
+      return VehicleType::Car;
     }
 
     friend std::ostream& operator<<(std::ostream& os, const Car& car) {
@@ -86,23 +260,24 @@ class Car : public Vehicle {
     NumberOfDoors m_number_of_doors;
 };
 
-class Truck : public Vehicle {
+class Truck final : public Vehicle {
   public:
-    Truck(RegistrationNumber registration_number, const std::string& owner_name, EngineCC engine_cc, MaxTruckWeight max_weight)
-        : Vehicle(registration_number, std::move(owner_name), engine_cc), m_max_weight(max_weight) {
-          if constexpr (Config::DEVELOPER_MODE) {
-            std::cout << "Truck object created: " << *this << '\n';
-          }
+    Truck(RegistrationNumber registration_number, std::string_view owner_name, EngineCC engine_cc, MaxTruckWeight max_weight,
+          std::pmr::memory_resource* names = std::pmr::get_default_resource())
+        : Vehicle(registration_number, owner_name, engine_cc, names), m_max_weight(max_weight) {
+          TRACE_OBJECT_CREATED("Truck", this);
     }
 
     ~Truck() noexcept override {
-      if constexpr (Config::DEVELOPER_MODE && Config::CONFIDENTIAL_OVERRIDE) {
-        std::cout << "Truck object created: " << *this << '\n';
-      }
+      TRACE_OBJECT_DESTROYED("Truck", this);
     }
 
     Tax CalculateTrafficTax() const override {
-      return (m_max_weight <= 3'000 ? 300 : m_max_weight <= 6'000 ? 400 : 600);
+      return TruckTrafficTax(m_max_weight);
+    }
+
+    VehicleType GetType() const override {
+      return VehicleType::Truck;
     }
 
     friend std::ostream& operator<<(std::ostream& os, const Truck& truck) {
@@ -115,6 +290,240 @@ class Truck : public Vehicle {
     MaxTruckWeight m_max_weight;
 };
 
+// Per-type slab pool: objects are built in place in fixed-size blocks of 'Config::FLEET_SLAB_VEHICLES',
+// so a large fleet costs one allocation per slab instead of one per vehicle, and neighbours in
+// insertion order are neighbours in memory. Objects never move; they all die with the pool.
+template<typename T>
+class SlabPool {
+  public:
+    SlabPool() = default;
+    SlabPool(const SlabPool&) = delete;
+    SlabPool& operator=(const SlabPool&) = delete;
+
+    ~SlabPool() {
+      Clear();
+    }
+
+    template<typename... Args>
+    T& Create(Args&&... args) {
+      if (m_size == m_slabs.size() * kSlabSize) {
+        m_slabs.push_back(std::unique_ptr<Slab>(new Slab)); // Uninitialized: 'std::make_unique' would zero the slab
+      }
+
+      T* object{new (m_slabs.back()->Slot(m_size % kSlabSize)) T(std::forward<Args>(args)...)};
+      ++m_size;
+      return *object;
+    }
+
+    // Runs the destructors (owner names may own memory), then returns every slab at once.
+    void Clear() noexcept {
+      if constexpr (!std::is_trivially_destructible_v<T>) {
+        ForEach([](T& object) { object.~T(); });
+      }
+      m_slabs.clear();
+      m_size = 0;
+    }
+
+    template<typename Visit>
+    void ForEach(const Visit& visit) const {
+      for (std::size_t i{0}; i < m_size; ++i) {
+        visit(*m_slabs[i / kSlabSize]->At(i % kSlabSize));
+      }
+    }
+
+  // Getters
+    std::size_t Size() const noexcept {
+      return m_size;
+    }
+
+  private:
+    static constexpr std::size_t kSlabSize{Config::FLEET_SLAB_VEHICLES};
+
+    struct Slab {
+      alignas(T) unsigned char storage[sizeof(T) * kSlabSize];
+
+      // Raw storage of a slot, for placement new; 'At' only once an object lives there.
+      void* Slot(std::size_t index) noexcept { return storage + index * sizeof(T); }
+      T* At(std::size_t index) noexcept { return std::launder(reinterpret_cast<T*>(Slot(index))); }
+    };
+
+    std::vector<std::unique_ptr<Slab>> m_slabs;
+    std::size_t m_size{0};
+};
+
+// Owning fleet of any size: cars and trucks come from their own slab pools, owners' names from one
+// monotonic buffer, and 'Vehicles' lists them in insertion order for the polymorphic code ('operator<<',
+// 'Vehicle::CalculateTotalTax', ...). Destroying (or clearing) the arena frees the whole fleet in one go.
+class FleetArena {
+  public:
+    void Reserve(std::size_t count) {
+      m_vehicles.reserve(count);
+    }
+
+    template<typename T, typename... Args>
+    T& Create(Args&&... args) {
+      static_assert(std::is_same_v<T, Car> || std::is_same_v<T, Truck>, "A fleet holds cars and trucks");
+
+      T* vehicle;
+      if constexpr (std::is_same_v<T, Car>) {
+        vehicle = &m_cars.Create(std::forward<Args>(args)..., &m_names);
+      } else {
+        vehicle = &m_trucks.Create(std::forward<Args>(args)..., &m_names);
+      }
+      m_vehicles.push_back(vehicle);
+      return *vehicle;
+    }
+
+    // Per pool, so each loop calls the 'final' override directly.
+    TotalTax CalculateTotalTax() const {
+      TotalTax total{0};
+      m_cars.ForEach([&total](const Car& car) { total += car.CalculateTrafficTax(); });
+      m_trucks.ForEach([&total](const Truck& truck) { total += truck.CalculateTrafficTax(); });
+      return total;
+    }
+
+    void Clear() noexcept {
+      m_vehicles.clear();
+      m_cars.Clear();
+      m_trucks.Clear();
+      m_names.release();
+    }
+
+  // Getters
+    const std::vector<Vehicle*>& Vehicles() const noexcept {
+      return m_vehicles;
+    }
+
+    std::size_t Size() const noexcept {
+      return m_vehicles.size();
+    }
+
+  private:
+    std::pmr::monotonic_buffer_resource m_names; // Before the pools: the names die after their vehicles
+    SlabPool<Car> m_cars;
+    SlabPool<Truck> m_trucks;
+    std::vector<Vehicle*> m_vehicles;
+};
+
+// Running tax totals for a registry that changes a little at a time: the overall total and the
+// aggregates per type and per owner are adjusted in O(1) on every change, instead of a full rescan.
+// The ledger indexes vehicles it does not own (e.g. from a 'FleetArena'); they must outlive it, and
+// their engine cc must only be changed through 'SetEngineCC' so the totals stay in step.
+class TaxLedger {
+  public:
+    struct Aggregate {
+      TotalTax tax{0};
+      std::size_t vehicles{0};
+    };
+
+    // False (and no change) if the registration number is already in the ledger.
+    bool Add(Vehicle& vehicle) {
+      const Tax tax{vehicle.CalculateTrafficTax()};
+      if (!m_by_registration.try_emplace(vehicle.GetRegistrationNumber(), Entry{&vehicle, tax}).second) {
+        return false;
+      }
+
+      Apply(vehicle, tax, +1);
+      return true;
+    }
+
+    bool Remove(RegistrationNumber registration_number) {
+      const auto it = m_by_registration.find(registration_number);
+      if (it == m_by_registration.end()) return false;
+
+      Apply(*it->second.vehicle, it->second.tax, -1);
+      m_by_registration.erase(it);
+      return true;
+    }
+
+    bool SetEngineCC(RegistrationNumber registration_number, EngineCC engine_cc) {
+      const auto it = m_by_registration.find(registration_number);
+      if (it == m_by_registration.end()) return false;
+
+      Entry& entry{it->second};
+      Apply(*entry.vehicle, entry.tax, -1);
+      entry.vehicle->SetEngineCC(engine_cc);
+      entry.tax = entry.vehicle->CalculateTrafficTax();
+      Apply(*entry.vehicle, entry.tax, +1);
+      return true;
+    }
+
+    // Nullptr if the registration number is not in the ledger.
+    const Vehicle* Find(RegistrationNumber registration_number) const {
+      const auto it = m_by_registration.find(registration_number);
+      return it == m_by_registration.end() ? nullptr : it->second.vehicle;
+    }
+
+  // Getters
+    TotalTax GetTotalTax() const noexcept {
+      return m_total.tax;
+    }
+
+    std::size_t Size() const noexcept {
+      return m_total.vehicles;
+    }
+
+    Aggregate GetTypeAggregate(VehicleType type) const noexcept {
+      return m_by_type[TypeIndex(type)];
+    }
+
+    Aggregate GetOwnerAggregate(std::string_view owner_name) const {
+      const auto it = FindOwner(m_by_owner, owner_name);
+      return it == m_by_owner.end() ? Aggregate{} : it->second;
+    }
+
+  private:
+    struct Entry {
+      Vehicle* vehicle;
+      Tax tax; // As last added, so removals and updates subtract exactly what was added
+    };
+
+    // Hashes 'std::string' and 'std::string_view' alike, so C++20 lookups take a view without a copy.
+    struct OwnerHash {
+      using is_transparent = void;
+      std::size_t operator()(std::string_view owner_name) const noexcept { return std::hash<std::string_view>{}(owner_name); }
+    };
+
+    // Each owner's name is owned by the index: the vehicles it came from may be removed and destroyed
+    // while the owner still has others in the ledger.
+    using OwnerIndex = std::unordered_map<std::string, Aggregate, OwnerHash, std::equal_to<>>;
+
+    static std::size_t TypeIndex(VehicleType type) noexcept {
+      return static_cast<std::size_t>(type) - 1;
+    }
+
+    template<typename Index> // 'OwnerIndex' or 'const OwnerIndex'
+    static auto FindOwner(Index& index, std::string_view owner_name) -> decltype(index.begin()) {
+      #if SUPPORTS_CPP20
+        return index.find(owner_name);
+      #else
+        return index.find(std::string(owner_name)); // No heterogeneous 'unordered_map' lookup before C++20
+      #endif // SUPPORTS_CPP20
+    }
+
+    // 'sign' is +1 to add 'tax' to every aggregate the vehicle belongs to, -1 to take it out again.
+    void Apply(const Vehicle& vehicle, Tax tax, int sign) {
+      const auto Update = [tax, sign](Aggregate& aggregate) {
+        aggregate.tax = sign > 0 ? aggregate.tax + tax : aggregate.tax - tax;
+        aggregate.vehicles = sign > 0 ? aggregate.vehicles + 1 : aggregate.vehicles - 1;
+      };
+
+      Update(m_total);
+      Update(m_by_type[TypeIndex(vehicle.GetType())]);
+
+      // The name is only copied for an owner's first vehicle.
+      auto owner = FindOwner(m_by_owner, vehicle.GetOwnerName());
+      if (owner == m_by_owner.end()) owner = m_by_owner.try_emplace(std::string(vehicle.GetOwnerName())).first;
+      Update(owner->second);
+      if (owner->second.vehicles == 0) m_by_owner.erase(owner);
+    }
+
+    std::unordered_map<RegistrationNumber, Entry> m_by_registration;
+    OwnerIndex m_by_owner;
+    std::array<Aggregate, 2> m_by_type{}; // Car, Truck
+    Aggregate m_total;
+};
+
 static void LocaleSetup() {
   // Because the locale is not always supported, I enforce it
   SetConsoleOutputCP(CP_UTF8);
@@ -123,7 +532,7 @@ static void LocaleSetup() {
 }
 
 template<typename T, typename... ExtraArgs>
-std::unique_ptr<Vehicle> CreateVehicle(ExtraArgs&&... extra_args) {
+T& CreateVehicle(FleetArena& fleet, ExtraArgs&&... extra_args) {
   RegistrationNumber registration_number;
   std::string owner_name;
   EngineCC engine_cc;
@@ -138,10 +547,10 @@ std::unique_ptr<Vehicle> CreateVehicle(ExtraArgs&&... extra_args) {
   std::cout << "5) Enter engine's cc: ";
   std::cin >> engine_cc;
 
-  return std::make_unique<T>(registration_number, std::move(owner_name), engine_cc, std::forward<ExtraArgs>(extra_args)...);
+  return fleet.Create<T>(registration_number, std::move(owner_name), engine_cc, std::forward<ExtraArgs>(extra_args)...);
 }
 
-void CollectVehicles(std::unique_ptr<Vehicle>* vehicles, std::size_t size){
+void CollectVehicles(FleetArena& fleet, std::size_t size){
   for (std::size_t i{0}; i < size; ++i) {
     int choice;
     std::cout << "\nCreate vehicle " << i + 1 << ":\n";
@@ -153,14 +562,14 @@ void CollectVehicles(std::unique_ptr<Vehicle>* vehicles, std::size_t size){
         NumberOfDoors number_of_doors;
         std::cout << "2) Enter number of doors: ";
         std::cin >> number_of_doors;
-        vehicles[i] = CreateVehicle<Car>(number_of_doors);
+        CreateVehicle<Car>(fleet, number_of_doors);
         break;
 
       case 2:
         MaxTruckWeight max_weight;
         std::cout << "2) Enter max weight: ";
         std::cin >> max_weight;
-        vehicles[i] = CreateVehicle<Truck>(max_weight);
+        CreateVehicle<Truck>(fleet, max_weight);
         break;
 
       default:
@@ -170,22 +579,578 @@ void CollectVehicles(std::unique_ptr<Vehicle>* vehicles, std::size_t size){
   }
 }
 
+// Devirtualized fleet: cars and trucks in their own contiguous arrays, so the tax loops call the
+// 'final' overrides directly (no pointer chase, no indirect call) and can be unrolled and vectorized.
+// Insertion order across the two types is not kept; use 'std::unique_ptr<Vehicle>' where it matters.
+class TypedFleet {
+  public:
+    void Reserve(std::size_t cars, std::size_t trucks) {
+      m_cars.reserve(cars);
+      m_trucks.reserve(trucks);
+    }
+
+    Car& AddCar(RegistrationNumber registration_number, std::string_view owner_name, EngineCC engine_cc, NumberOfDoors number_of_doors) {
+      return m_cars.emplace_back(registration_number, owner_name, engine_cc, number_of_doors);
+    }
 
-int main() {
+    Truck& AddTruck(RegistrationNumber registration_number, std::string_view owner_name, EngineCC engine_cc, MaxTruckWeight max_weight) {
+      return m_trucks.emplace_back(registration_number, owner_name, engine_cc, max_weight);
+    }
+
+    // 64-bit totals: a large fleet overflows 'Tax'.
+    TotalTax CalculateCarTax() const {
+      TotalTax total{0};
+      for (const Car& car : m_cars) {
+        total += car.CalculateTrafficTax();
+      }
+      return total;
+    }
+
+    TotalTax CalculateTruckTax() const {
+      TotalTax total{0};
+      for (const Truck& truck : m_trucks) {
+        total += truck.CalculateTrafficTax();
+      }
+      return total;
+    }
+
+    TotalTax CalculateTotalTax() const {
+      return CalculateCarTax() + CalculateTruckTax();
+    }
+
+  // Getters
+    const std::vector<Car>& GetCars() const {
+      return m_cars;
+    }
+
+    const std::vector<Truck>& GetTrucks() const {
+      return m_trucks;
+    }
+
+    std::size_t Size() const {
+      return m_cars.size() + m_trucks.size();
+    }
+
+  private:
+    std::vector<Car> m_cars;
+    std::vector<Truck> m_trucks;
+};
+
+// Whole-field parse: rejects empty fields, trailing junk and values that do not fit in 'Number'.
+template<typename Number>
+std::optional<Number> ParseNumber(std::string_view field) {
+  Number value{};
+  const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+  if (error != std::errc() || end != field.data() + field.size()) return std::nullopt;
+  return value;
+}
+
+// Bulk input parsed into columns; row 'i' of every vector describes the same vehicle.
+// 'owner_names' view the input text, which must outlive this object.
+struct BulkVehicles {
+  std::vector<VehicleType> types;
+  std::vector<RegistrationNumber> registration_numbers;
+  std::vector<std::string_view> owner_names;
+  std::vector<EngineCC> engine_ccs;
+  std::vector<std::uint32_t> extras; // Number of doors for cars, max weight for trucks
+  std::size_t malformed{0};
+
+  std::size_t Size() const noexcept { return types.size(); }
+};
+
+// One vehicle per line, in the order of the interactive prompts:
+//   type (1 = Car, 2 = Truck), registration number, owner's name, engine's cc, doors | max weight
+// separated by commas. Malformed lines are reported by line number and skipped.
+static BulkVehicles ParseVehicles(std::string_view text) {
+  BulkVehicles input;
+  std::string_view fields[5];
+  std::size_t line_number{0};
+
+  while (!text.empty()) {
+    const std::size_t newline{text.find('\n')};
+    std::string_view line{input::Trim(text.substr(0, newline))};
+    text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+    ++line_number;
+    if (line.empty()) continue;
+
+    std::size_t count{0};
+    for (; count < 5 && !line.empty(); ++count) {
+      const std::size_t comma{line.find(',')};
+      fields[count] = input::Trim(line.substr(0, comma));
+      line.remove_prefix(comma == std::string_view::npos ? line.size() : comma + 1);
+    }
+
+    const auto type = count == 5 && line.empty() ? ParseNumber<unsigned int>(fields[0]) : std::nullopt;
+    const auto registration_number = ParseNumber<RegistrationNumber>(fields[1]);
+    const auto engine_cc = ParseNumber<EngineCC>(fields[3]);
+    const auto extra = ParseNumber<std::uint32_t>(fields[4]);
+    const bool valid_type{type && (*type == 1 || *type == 2)};
+    const bool valid_doors{valid_type && (*type != 1 || (extra && *extra <= std::numeric_limits<NumberOfDoors>::max()))};
+
+    if (!valid_type || !registration_number || fields[2].empty() || !engine_cc || !extra || !valid_doors) {
+      ++input.malformed;
+      std::cerr << "Line " << line_number << ": expected 'type,registration,owner,cc,doors|max weight'; skipped.\n";
+      continue;
+    }
+
+    input.types.push_back(static_cast<VehicleType>(*type));
+    input.registration_numbers.push_back(*registration_number);
+    input.owner_names.push_back(fields[2]);
+    input.engine_ccs.push_back(*engine_cc);
+    input.extras.push_back(*extra);
+  }
+
+  return input;
+}
+
+// Structure-of-arrays fleet for batch tax runs: one dense column per field, row 'i' of every column
+// describing the same vehicle. Cars store 0 as max weight, trucks 0 doors.
+class FleetTable {
+  public:
+    static constexpr std::uint32_t kSnapshotKind{snapshot::Kind("FLTB")};
+
+    static FleetTable From(const BulkVehicles& input) {
+      FleetTable table;
+      table.Reserve(input.Size());
+      for (std::size_t i{0}; i < input.Size(); ++i) {
+        if (input.types[i] == VehicleType::Car) {
+          table.AddCar(input.registration_numbers[i], input.engine_ccs[i], static_cast<NumberOfDoors>(input.extras[i]));
+        } else {
+          table.AddTruck(input.registration_numbers[i], input.engine_ccs[i], static_cast<MaxTruckWeight>(input.extras[i]));
+        }
+      }
+      return table;
+    }
+
+    void Reserve(std::size_t count) {
+      m_types.reserve(count);
+      m_registration_numbers.reserve(count);
+      m_engine_ccs.reserve(count);
+      m_doors.reserve(count);
+      m_max_weights.reserve(count);
+    }
+
+    void AddCar(RegistrationNumber registration_number, EngineCC engine_cc, NumberOfDoors number_of_doors) {
+      Add(VehicleType::Car, registration_number, engine_cc, number_of_doors, 0);
+    }
+
+    void AddTruck(RegistrationNumber registration_number, EngineCC engine_cc, MaxTruckWeight max_weight) {
+      Add(VehicleType::Truck, registration_number, engine_cc, 0, max_weight);
+    }
+
+  // Getters
+    std::size_t Size() const noexcept { return m_types.size(); }
+    const VehicleType* Types() const noexcept { return m_types.data(); }
+    const RegistrationNumber* RegistrationNumbers() const noexcept { return m_registration_numbers.data(); }
+    const EngineCC* EngineCCs() const noexcept { return m_engine_ccs.data(); }
+    const NumberOfDoors* Doors() const noexcept { return m_doors.data(); }
+    const MaxTruckWeight* MaxWeights() const noexcept { return m_max_weights.data(); }
+
+    // Every column as is, for 'FleetTableView'.
+    std::error_code SaveSnapshot(const std::string& path) const {
+      return snapshot::Write(path, kSnapshotKind, Size(), {snapshot::ColumnOf(m_types), snapshot::ColumnOf(m_registration_numbers),
+                             snapshot::ColumnOf(m_engine_ccs), snapshot::ColumnOf(m_doors), snapshot::ColumnOf(m_max_weights)});
+    }
+
+  private:
+    void Add(VehicleType type, RegistrationNumber registration_number, EngineCC engine_cc, NumberOfDoors number_of_doors, MaxTruckWeight max_weight) {
+      m_types.push_back(type);
+      m_registration_numbers.push_back(registration_number);
+      m_engine_ccs.push_back(engine_cc);
+      m_doors.push_back(number_of_doors);
+      m_max_weights.push_back(max_weight);
+    }
+
+    std::vector<VehicleType> m_types;
+    std::vector<RegistrationNumber> m_registration_numbers;
+    std::vector<EngineCC> m_engine_ccs;
+    std::vector<NumberOfDoors> m_doors;
+    std::vector<MaxTruckWeight> m_max_weights;
+};
+
+// Read-only 'FleetTable' served from a snapshot file ('FleetTable::SaveSnapshot'): the same column
+// getters, pointing into the mapping, so the batch tax kernels below run on it unchanged and
+// loading a fleet of any size costs one header check instead of a parse of every line.
+class FleetTableView {
+  public:
+    static std::variant<FleetTableView, std::error_code> Open(const std::string& path) {
+      auto opened = snapshot::MappedSnapshot::Open(path, FleetTable::kSnapshotKind);
+      if (const auto* error = std::get_if<std::error_code>(&opened)) return *error;
+
+      FleetTableView view{std::move(std::get<snapshot::MappedSnapshot>(opened))};
+      const snapshot::MappedSnapshot& mapped{view.m_snapshot};
+      const std::size_t rows{mapped.Rows()};
+      view.m_types = mapped.Column<VehicleType>(0, rows);
+      view.m_registration_numbers = mapped.Column<RegistrationNumber>(1, rows);
+      view.m_engine_ccs = mapped.Column<EngineCC>(2, rows);
+      view.m_doors = mapped.Column<NumberOfDoors>(3, rows);
+      view.m_max_weights = mapped.Column<MaxTruckWeight>(4, rows);
+      if (!view.m_types || !view.m_registration_numbers || !view.m_engine_ccs || !view.m_doors || !view.m_max_weights) {
+        return snapshot::make_error_code(snapshot::Error::BadColumn);
+      }
+      return view;
+    }
+
+  // Getters
+    std::size_t Size() const noexcept { return m_snapshot.Rows(); }
+    const VehicleType* Types() const noexcept { return m_types; }
+    const RegistrationNumber* RegistrationNumbers() const noexcept { return m_registration_numbers; }
+    const EngineCC* EngineCCs() const noexcept { return m_engine_ccs; }
+    const NumberOfDoors* Doors() const noexcept { return m_doors; }
+    const MaxTruckWeight* MaxWeights() const noexcept { return m_max_weights; }
+
+  private:
+    explicit FleetTableView(snapshot::MappedSnapshot mapped) : m_snapshot(std::move(mapped)) {}
+
+    snapshot::MappedSnapshot m_snapshot;
+    const VehicleType* m_types{nullptr};
+    const RegistrationNumber* m_registration_numbers{nullptr};
+    const EngineCC* m_engine_ccs{nullptr};
+    const NumberOfDoors* m_doors{nullptr};
+    const MaxTruckWeight* m_max_weights{nullptr};
+};
+
+static_assert(sizeof(VehicleType) == 1, "The AVX2 kernel loads the type column as bytes");
+
+#if SUPPORTS_AVX2
+  // Taxes of rows [i, i + 8): both formulas on all eight lanes, then a blend on the type tag.
+  template<typename Policy, typename Table>
+  static __m256i TrafficTaxes8(const Table& table, std::size_t i) {
+    const __m256i type{_mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(table.Types() + i)))};
+    const __m256i engine_cc{_mm256_cvtepu16_epi32(_mm_loadu_si128(reinterpret_cast<const __m128i*>(table.EngineCCs() + i)))};
+    const __m256i max_weight{_mm256_loadu_si256(reinterpret_cast<const __m256i*>(table.MaxWeights() + i))};
+
+    // Car: gather from the 16-bit table (scale 2, then keep the low half of each 4-byte load).
+    const auto* car_taxes = reinterpret_cast<const int*>(CarTaxTable<Policy>::kTaxes.data());
+    const __m256i car_tax{_mm256_and_si256(_mm256_i32gather_epi32(car_taxes, engine_cc, 2), _mm256_set1_epi32(0xFFFF))};
+
+    // Truck: base plus each tier's surcharge where the weight is above it; AVX2 only compares signed, so bias by 2^31.
+    const __m256i bias{_mm256_set1_epi32(std::numeric_limits<std::int32_t>::min())};
+    const __m256i weight{_mm256_xor_si256(max_weight, bias)};
+    __m256i truck_tax{_mm256_set1_epi32(static_cast<int>(Policy::kTruckBaseTax))};
+    for (const TruckTier& tier : Policy::kTruckTiers) {
+      const __m256i above{_mm256_cmpgt_epi32(weight, _mm256_xor_si256(_mm256_set1_epi32(static_cast<int>(tier.above)), bias))};
+      truck_tax = _mm256_add_epi32(truck_tax, _mm256_and_si256(above, _mm256_set1_epi32(static_cast<int>(tier.surcharge))));
+    }
+
+    const __m256i is_car{_mm256_cmpeq_epi32(type, _mm256_set1_epi32(static_cast<int>(VehicleType::Car)))};
+    return _mm256_blendv_epi8(truck_tax, car_tax, is_car);
+  }
+#endif // SUPPORTS_AVX2
+
+template<typename Policy, typename Table>
+static Tax TrafficTax(const Table& table, std::size_t i) {
+  const Tax car_tax{CarTrafficTax<Policy>(table.EngineCCs()[i])};
+  const Tax truck_tax{TruckTrafficTax<Policy>(table.MaxWeights()[i])};
+  return table.Types()[i] == VehicleType::Car ? car_tax : truck_tax; // Both computed: a select, not a branch
+}
+
+// Per-vehicle taxes; 'out' must hold 'table.Size()' values. 'Table' is a 'FleetTable' or a 'FleetTableView'.
+template<typename Policy = Config::TaxPolicy, typename Table>
+static void CalculateTaxes(const Table& table, Tax* out) {
+  const std::size_t count{table.Size()};
+  std::size_t i{0};
+
+  #if SUPPORTS_AVX2
+    for (; i + 8 <= count; i += 8) {
+      _mm256_storeu_si256(reinterpret_cast<__m256i*>(out + i), TrafficTaxes8<Policy>(table, i));
+    }
+  #endif // SUPPORTS_AVX2
+
+  for (; i < count; ++i) {
+    out[i] = TrafficTax<Policy>(table, i);
+  }
+}
+
+template<typename Policy = Config::TaxPolicy, typename Table>
+static std::vector<Tax> CalculateTaxes(const Table& table) {
+  std::vector<Tax> taxes(table.Size());
+  CalculateTaxes<Policy>(table, taxes.data());
+  return taxes;
+}
+
+template<typename Policy = Config::TaxPolicy, typename Table>
+static TotalTax CalculateTotalTax(const Table& table) {
+  const std::size_t count{table.Size()};
+  TotalTax total{0};
+  std::size_t i{0};
+
+  #if SUPPORTS_AVX2
+    __m256i low_sum{_mm256_setzero_si256()};
+    __m256i high_sum{_mm256_setzero_si256()};
+    for (; i + 8 <= count; i += 8) {
+      const __m256i taxes{TrafficTaxes8<Policy>(table, i)};
+      low_sum = _mm256_add_epi64(low_sum, _mm256_cvtepu32_epi64(_mm256_castsi256_si128(taxes)));
+      high_sum = _mm256_add_epi64(high_sum, _mm256_cvtepu32_epi64(_mm256_extracti128_si256(taxes, 1)));
+    }
+
+    alignas(32) std::uint64_t lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), _mm256_add_epi64(low_sum, high_sum));
+    total = lanes[0] + lanes[1] + lanes[2] + lanes[3];
+  #endif // SUPPORTS_AVX2
+
+  for (; i < count; ++i) {
+    total += TrafficTax<Policy>(table, i);
+  }
+  return total;
+}
+
+// Usage: run.exe --bulk [file|-] [text|csv|binary] - reads vehicles from 'file' (or standard input) and prints
+// the summary, as text by default. For CSV and binary the rows go to standard output and the total to
+// standard error, so standard output holds the records only.
+static int RunBulkMode(const char* path, output::Format format) {
+  std::FILE* stream{path ? std::fopen(path, "rb") : stdin};
+  if (!stream) {
+    std::cerr << "Error: Cannot open '" << path << "'.\n";
+    return EXIT_FAILURE;
+  }
+
+  const std::string text{input::ReadAll(stream)};
+  if (path) std::fclose(stream);
+
+  const BulkVehicles input{ParseVehicles(text)};
+  FleetArena fleet;
+  fleet.Reserve(input.Size());
+
+  for (std::size_t i{0}; i < input.Size(); ++i) {
+    const std::string_view owner_name{input.owner_names[i]};
+    if (input.types[i] == VehicleType::Car) {
+      fleet.Create<Car>(input.registration_numbers[i], owner_name, input.engine_ccs[i], static_cast<NumberOfDoors>(input.extras[i]));
+    } else {
+      fleet.Create<Truck>(input.registration_numbers[i], owner_name, input.engine_ccs[i], static_cast<MaxTruckWeight>(input.extras[i]));
+    }
+  }
+  const std::vector<Vehicle*>& vehicles{fleet.Vehicles()};
+
+  const std::vector<Tax> taxes{CalculateTaxes(FleetTable::From(input))}; // One batch pass instead of a virtual call per row
+
+  TotalTax total{0}; // From the printed rows, so the total always matches them
+  {
+    output::Writer out{stdout, format};
+    if (format == output::Format::Text) out << "Summary of vehicles:\n";
+    out.Header({"type", "registration_number", "owner_name", "engine_cc", "tax"});
+    for (std::size_t i{0}; i < vehicles.size(); ++i) {
+      WriteRecord(out, *vehicles[i], taxes[i]);
+      total += taxes[i];
+    }
+  } // Flushed here, before the total
+
+  std::ostream& summary{format == output::Format::Text ? std::cout : std::cerr};
+  summary << "\nTotal tax for all vehicles: €" << total
+      << " (vehicles: " << vehicles.size() << ", malformed lines: " << input.malformed << ")\n";
+
+  return input.malformed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// Usage: run.exe --save-snapshot <snapshot> [file|-] - reads vehicles like '--bulk' and saves their 'FleetTable'
+// (owners' names are not part of it) for '--load-snapshot'.
+static int RunSaveSnapshotMode(const char* snapshot_path, const char* path) {
+  std::FILE* stream{path ? std::fopen(path, "rb") : stdin};
+  if (!stream) {
+    std::cerr << "Error: Cannot open '" << path << "'.\n";
+    return EXIT_FAILURE;
+  }
+
+  const std::string text{input::ReadAll(stream)};
+  if (path) std::fclose(stream);
+
+  const BulkVehicles input{ParseVehicles(text)};
+  const FleetTable table{FleetTable::From(input)};
+  if (const std::error_code error{table.SaveSnapshot(snapshot_path)}) {
+    std::cerr << "Error: Cannot write '" << snapshot_path << "': " << error.message() << '\n';
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Saved " << table.Size() << " vehicles to '" << snapshot_path << "' (malformed lines: " << input.malformed << ")\n";
+  return input.malformed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// Usage: run.exe --load-snapshot <snapshot> - total tax of a saved fleet, computed on the mapped columns.
+static int RunLoadSnapshotMode(const char* snapshot_path) {
+  auto opened = FleetTableView::Open(snapshot_path);
+  if (const auto* error = std::get_if<std::error_code>(&opened)) {
+    std::cerr << "Error: Cannot load '" << snapshot_path << "': " << error->message() << '\n';
+    return EXIT_FAILURE;
+  }
+  const FleetTableView& table{std::get<FleetTableView>(opened)};
+
+  std::cout << "Total tax for all vehicles: €" << CalculateTotalTax(table) << " (vehicles: " << table.Size() << ", from snapshot)\n";
+  return EXIT_SUCCESS;
+}
+
+#if BENCHMARK_ENABLED
+// Usage: run.exe --benchmark [max_vehicles] - total tax of random fleets through 'std::unique_ptr<Vehicle>'
+// virtual dispatch, 'TypedFleet', 'FleetTable' and its snapshot view, and the cost of building them, from 1K
+// up to 'max_vehicles' (1K, 10K, ...; default 10M, ~1 GB). Every total is checked against 'TypedFleet', and
+// the highest tax ('reduce::max_of' on the tax column) against a plain scan. A 'TaxLedger' of the vehicles
+// with unique registration numbers is checked too, as is its owner aggregate after a removal.
+static int RunTaxBenchmark(std::size_t max_vehicles) {
+  bench::Generator generator;
+  const std::string owner_name{"Konstantinos Papadopoulos"}; // Past the small-string buffer, like most full names
+  bench::PrintHeader();
+
+  for (std::size_t count : bench::Scales(max_vehicles)) {
+    std::vector<std::unique_ptr<Vehicle>> vehicles;
+    vehicles.reserve(count);
+    std::vector<bool> is_car(count);
+    std::size_t cars{0};
+    for (std::size_t i{0}; i < count; ++i) {
+      is_car[i] = generator.Chance(0.5);
+      cars += is_car[i];
+    }
+
+    TypedFleet fleet;
+    fleet.Reserve(cars, count - cars);
+    FleetTable table;
+    table.Reserve(count);
+    for (std::size_t i{0}; i < count; ++i) {
+      const auto registration_number = static_cast<RegistrationNumber>(i);
+      const auto engine_cc = generator.Uniform<EngineCC>(800, 3'999);
+      if (is_car[i]) {
+        const auto number_of_doors = generator.Uniform<NumberOfDoors>(2, 5);
+        vehicles.push_back(std::make_unique<Car>(registration_number, owner_name, engine_cc, number_of_doors));
+        fleet.AddCar(registration_number, owner_name, engine_cc, number_of_doors);
+        table.AddCar(registration_number, engine_cc, number_of_doors);
+      } else {
+        const auto max_weight = generator.Uniform<MaxTruckWeight>(1'000, 9'999);
+        vehicles.push_back(std::make_unique<Truck>(registration_number, owner_name, engine_cc, max_weight));
+        fleet.AddTruck(registration_number, owner_name, engine_cc, max_weight);
+        table.AddTruck(registration_number, engine_cc, max_weight);
+      }
+    }
+
+    TotalTax virtual_total{0}, parallel_total{0}, typed_total{0}, table_total{0};
+    bench::Run("CalculateTotalTax (virtual)", count, [&] {
+      virtual_total = Vehicle::CalculateTotalTax(vehicles.data(), vehicles.size());
+    });
+    bench::Run("CalculateTotalTaxParallel", count, [&] {
+      parallel_total = Vehicle::CalculateTotalTaxParallel(vehicles.data(), vehicles.size());
+    });
+    bench::Run("TypedFleet::CalculateTotalTax", count, [&] { typed_total = fleet.CalculateTotalTax(); });
+    bench::Run("CalculateTotalTax (FleetTable)", count, [&] { table_total = CalculateTotalTax(table); });
+
+    // Restart: saving the table and mapping it back; the view's total goes through the same kernel.
+    const std::string path{bench::TemporaryPath("fleet.snapshot")};
+    bench::Run("FleetTable::SaveSnapshot", count, [&] { bench::DoNotOptimize(table.SaveSnapshot(path)); });
+    bench::Run("FleetTableView::Open", count, [&] { bench::DoNotOptimize(FleetTableView::Open(path).index()); });
+
+    auto opened = FleetTableView::Open(path);
+    const FleetTableView* view{std::get_if<FleetTableView>(&opened)};
+    TotalTax view_total{0};
+    if (view) bench::Run("CalculateTotalTax (FleetTableView)", count, [&] { view_total = CalculateTotalTax(*view); });
+    std::error_code ignored;
+    std::filesystem::remove(path, ignored);
+
+    if (virtual_total != typed_total || parallel_total != typed_total || table_total != typed_total || view_total != typed_total) {
+      std::cerr << "Error: the fleets disagree at " << count << " vehicles (" << virtual_total << ", " << parallel_total
+                << ", " << typed_total << ", " << table_total << ", " << view_total << ").\n";
+      return EXIT_FAILURE;
+    }
+
+    const std::vector<Tax> taxes{CalculateTaxes(table)};
+    Tax highest{0};
+    bench::Run("reduce::max_of (taxes)", count, [&] { highest = reduce::max_of(taxes); });
+    if (highest != *std::max_element(taxes.begin(), taxes.end())) {
+      std::cerr << "Error: the highest tax disagrees at " << count << " vehicles.\n";
+      return EXIT_FAILURE;
+    }
+
+    // Incremental totals: the ledger must agree with the batch total, and the owner's aggregate must survive
+    // its first vehicle being removed and destroyed (the owner index must not refer to that vehicle's name).
+    // Registration numbers are 16-bit, so past 65,536 vehicles they repeat and only the first ones are unique.
+    const std::size_t unique{std::min<std::size_t>(count, std::size_t{std::numeric_limits<RegistrationNumber>::max()} + 1)};
+    TaxLedger ledger;
+    bench::Run("TaxLedger::Add", unique, [&] { ledger = TaxLedger{}; }, [&] {
+      for (std::size_t i{0}; i < unique; ++i) ledger.Add(*vehicles[i]);
+    });
+    const TotalTax expected_total{Vehicle::CalculateTotalTax(vehicles.data(), unique)};
+    const TotalTax ledger_total{ledger.GetTotalTax()};
+    const Tax first_tax{vehicles.front()->CalculateTrafficTax()};
+    ledger.Remove(vehicles.front()->GetRegistrationNumber());
+    vehicles.front().reset();
+    const TaxLedger::Aggregate owner{ledger.GetOwnerAggregate(std::string(owner_name))};
+
+    if (ledger_total != expected_total || owner.vehicles != unique - 1 || owner.tax != expected_total - first_tax) {
+      std::cerr << "Error: the ledger disagrees at " << count << " vehicles (" << ledger_total << ", owner "
+                << owner.tax << " over " << owner.vehicles << " vehicles after one removal).\n";
+      return EXIT_FAILURE;
+    }
+
+    // Construction and teardown: two heap allocations per vehicle (object and owner's name) versus the slab
+    // pools and the name buffer of 'FleetArena'.
+    bench::Run("Build + free (std::make_unique)", count, [&] {
+      std::vector<std::unique_ptr<Vehicle>> heap_fleet;
+      heap_fleet.reserve(count);
+      for (std::size_t i{0}; i < count; ++i) {
+        if (is_car[i]) {
+          heap_fleet.push_back(std::make_unique<Car>(static_cast<RegistrationNumber>(i), owner_name, 1'500, 4));
+        } else {
+          heap_fleet.push_back(std::make_unique<Truck>(static_cast<RegistrationNumber>(i), owner_name, 1'500, 5'000));
+        }
+      }
+    });
+    bench::Run("Build + free (FleetArena)", count, [&] {
+      FleetArena arena;
+      arena.Reserve(count);
+      for (std::size_t i{0}; i < count; ++i) {
+        if (is_car[i]) {
+          arena.Create<Car>(static_cast<RegistrationNumber>(i), owner_name, 1'500, 4);
+        } else {
+          arena.Create<Truck>(static_cast<RegistrationNumber>(i), owner_name, 1'500, 5'000);
+        }
+      }
+    });
+  }
+
+  return EXIT_SUCCESS;
+}
+#endif // BENCHMARK_ENABLED
+
+
+int main(int argc, char* argv[]) {
   LocaleSetup(); // To display the euro sign in cmd
 
+  if (argc > 1 && std::string_view(argv[1]) == "--bulk") {
+    const std::optional<output::Format> format{argc > 3 ? output::ParseFormat(argv[3]) : output::Format::Text};
+    if (!format) {
+      std::cerr << "Error: Unknown format '" << argv[3] << "' (expected text, csv or binary).\n";
+      return EXIT_FAILURE;
+    }
+    return RunBulkMode(argc > 2 && std::string_view(argv[2]) != "-" ? argv[2] : nullptr, *format);
+  }
+
+  if (argc > 2 && std::string_view(argv[1]) == "--save-snapshot") {
+    return RunSaveSnapshotMode(argv[2], argc > 3 && std::string_view(argv[3]) != "-" ? argv[3] : nullptr);
+  }
+
+  if (argc > 2 && std::string_view(argv[1]) == "--load-snapshot") {
+    return RunLoadSnapshotMode(argv[2]);
+  }
+
+  if (argc > 1 && std::string_view(argv[1]) == "--benchmark") {
+    #if BENCHMARK_ENABLED
+      return RunTaxBenchmark(bench::ParseCount(argc > 2 ? argv[2] : nullptr, 10'000'000));
+    #else
+      std::cerr << "Error: '--benchmark' needs a build with -DENABLE_BENCHMARK.\n";
+      return EXIT_FAILURE;
+    #endif // BENCHMARK_ENABLED
+  }
+
   constexpr NumberOfVehicles kNumberOfVehicles{5};
-  std::unique_ptr<Vehicle> vehicles[kNumberOfVehicles];
+  FleetArena fleet; // Grows as needed; 'kNumberOfVehicles' is only how many the prompts ask for
 
-  CollectVehicles(vehicles, kNumberOfVehicles);
+  CollectVehicles(fleet, kNumberOfVehicles);
 
-  std::cout << "\nSummary of vehicles:\n";
-  for (std::size_t i{0}; i < kNumberOfVehicles; ++i) {
-    std::cout << *vehicles[i] << " - €" << vehicles[i]->CalculateTrafficTax() << '\n';
+  {
+    output::Writer out{stdout, output::Format::Text, 4'096};
+    out << "\nSummary of vehicles:\n";
+    for (const Vehicle* vehicle : fleet.Vehicles()) {
+      WriteRecord(out, *vehicle, vehicle->CalculateTrafficTax());
+    }
   }
 
   std::cout << "\nTotal tax for all vehicles: €"
-      << Vehicle::CalculateTotalTax(vehicles, kNumberOfVehicles) << '\n';
+      << Vehicle::CalculateTotalTax(fleet.Vehicles().data(), fleet.Size()) << '\n';
 
   return 0;
 }
@@ -5,16 +5,96 @@
 #include <iostream>
 #include <cstdint>
 #include <string>
+#include <string_view>
+#include <cstdlib>
 #include <memory>
+#include <vector>
+#include <array>
+#include <atomic>
+#include <charconv> // 'std::from_chars' for the snapshot input
+#include <cstddef>
+#include <cstdio>
+#include <filesystem>
+#include <limits>
+#include <optional>
+#include <system_error>
+#include <utility>
+#include <variant>
+#include "../common/trace.h" // Lifecycle events and timings; compiled out unless -DENABLE_TRACING
+#include "../common/bench.h" // '--benchmark' harness and data generators; compiled out unless -DENABLE_BENCHMARK
+#include "../common/output.h" // Buffered text/CSV/binary reports
+#include "../common/input.h" // Whole-stream reads for '--save-snapshot'
+#include "../common/snapshot.h" // Binary snapshots loaded by memory mapping
 
 using Age = std::uint8_t;
 using MaxInstances = std::uint8_t; // Depends on the size of the program.
+using InstanceCount = std::uint64_t; // Instance tracking: does not wrap like 'MaxInstances' would
 
 namespace Config {
   constexpr bool DEVELOPER_MODE{true};
-  constexpr bool CONFIDENTIAL_OVERRIDE{true};
+
+  // Cache-line shards per 'InstanceCounter'; threads beyond this share shards (still correct, just contended).
+  constexpr std::size_t COUNTER_SHARDS{64};
+}
+
+struct InstanceCounts {
+  InstanceCount created{0};
+  InstanceCount destroyed{0};
+
+  InstanceCount Live() const noexcept { return created - destroyed; }
+};
+
+// Slot of the calling thread in every 'InstanceCounter', handed out round-robin on first use.
+inline std::size_t CounterShardIndex() noexcept {
+  static std::atomic<std::size_t> next_shard{0};
+  thread_local const std::size_t shard{next_shard.fetch_add(1, std::memory_order_relaxed) % Config::COUNTER_SHARDS};
+  return shard;
 }
 
+// Created/destroyed counts of one type, safe to bump from any thread and cheap enough to leave on in
+// production: each thread writes its own cache-line-sized shard (no line bounces between cores), and
+// 'Read' sums the shards. Counts are exact once the writers are done; a concurrent read may be a
+// few increments behind.
+template<typename T>
+class InstanceCounter {
+  public:
+    static void OnCreated() noexcept {
+      s_shards[CounterShardIndex()].created.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static void OnDestroyed() noexcept {
+      s_shards[CounterShardIndex()].destroyed.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    static InstanceCounts Read() noexcept {
+      InstanceCounts counts;
+      for (const Shard& shard : s_shards) {
+        counts.created += shard.created.load(std::memory_order_relaxed);
+        counts.destroyed += shard.destroyed.load(std::memory_order_relaxed);
+      }
+      return counts;
+    }
+
+  private:
+    struct alignas(64) Shard { // 64: a cache line on current x86 and ARM cores
+      std::atomic<InstanceCount> created{0};
+      std::atomic<InstanceCount> destroyed{0};
+    };
+
+    inline static std::array<Shard, Config::COUNTER_SHARDS> s_shards{};
+};
+
+// Member that counts its owner in 'InstanceCounter<T>'; copies count as new instances, so the live
+// count stays right whichever way an object is made.
+template<typename T>
+class InstanceTracker {
+  public:
+    InstanceTracker() noexcept { InstanceCounter<T>::OnCreated(); }
+    InstanceTracker(const InstanceTracker&) noexcept : InstanceTracker() {}
+    InstanceTracker& operator=(const InstanceTracker&) noexcept = default; // Assignment creates nothing
+    ~InstanceTracker() noexcept { InstanceCounter<T>::OnDestroyed(); }
+};
+
 template<typename T, typename... ExtraArgs>
 auto CreatePerson(ExtraArgs&&... extra_args) -> std::unique_ptr<T> {
   std::uint16_t age;
@@ -29,22 +109,18 @@ auto CreatePerson(ExtraArgs&&... extra_args) -> std::unique_ptr<T> {
 class Person {
   public:
     Person(Age age) : m_age(age) {
-      if constexpr (Config::DEVELOPER_MODE) {
-        ++number_of_instances;
-        std::cout << "Person object created: " << *this << '\n';
-      }
+      TRACE_OBJECT_CREATED("Person", this);
     }
 
     virtual ~Person() noexcept {
-      if constexpr (Config::DEVELOPER_MODE && Config::CONFIDENTIAL_OVERRIDE) {
-        std::cout << "Person object destroyed: " << *this << '\n';
-      }
+      TRACE_OBJECT_DESTROYED("Person", this);
     }
 
-    virtual double ComputeEarnings() = 0;
+    virtual double ComputeEarnings() const = 0;
 
-    static MaxInstances GetNumberOfInstances() {
-      return number_of_instances;
+    // Live 'Person' objects (of any type), counted from every thread.
+    static InstanceCount GetNumberOfInstances() {
+      return InstanceCounter<Person>::Read().Live();
     }
 
     // Possible causes for the problem:
@@ -64,9 +140,18 @@ class Person {
       return os << numeric_age;
     }
 
+    // Bulk output: one summary line ('operator<<' and the earnings), or one CSV/binary record 'age, earnings'.
+    // 'output::Writer' prints 'std::uint8_t' as a number, so no cast is needed here.
+    friend void WriteRecord(output::Writer& out, const Person& person) {
+      if (out.GetFormat() == output::Format::Text) {
+        out << person.m_age << " - Earnings: $" << person.ComputeEarnings() << '\n';
+      } else {
+        out.Record(person.m_age, person.ComputeEarnings());
+      }
+    }
+
   private:
-    // Shared across all instances of a class, but with private access (through the getter).
-    static MaxInstances number_of_instances;
+    InstanceTracker<Person> m_instance_tracker;
 
   protected:
     Age m_age;
@@ -76,54 +161,308 @@ class Teacher : public Person {
   public:
     Teacher(Age age, std::string profession)
         : Person(age), m_profession(std::move(profession)) {
-      if constexpr (Config::DEVELOPER_MODE) {
-        std::cout << "Teacher object created: " << *this << '\n';
-      }
+      TRACE_OBJECT_CREATED("Teacher", this);
     }
 
     virtual ~Teacher() noexcept override {
-      if constexpr (Config::DEVELOPER_MODE && Config::CONFIDENTIAL_OVERRIDE) {
-        std::cout << "Teacher object destroyed: " << *this << '\n';
-      }
+      TRACE_OBJECT_DESTROYED("Teacher", this);
     }
 
     friend std::ostream& operator<<(std::ostream& os, const Teacher& teacher) {
       return os << +teacher.m_age << ", " << teacher.m_profession;
     }
 
-    double ComputeEarnings() override {
-      return 1'000.0;
+    // Same for every teacher; 'PeopleStore' pays teachers as 'count * kEarnings'.
+    static constexpr double kEarnings{1'000.0};
+
+    double ComputeEarnings() const override {
+      return kEarnings;
     }
 
   private:
     std::string m_profession;
+    InstanceTracker<Teacher> m_instance_tracker;
 };
 
 class Footballer : public Person {
   public:
     Footballer(Age age, std::string team)
         : Person(age), m_team(std::move(team)) {
-      if constexpr (Config::DEVELOPER_MODE) {
-        std::cout << "Footballer object created: " << *this << '\n';
-      }
+      TRACE_OBJECT_CREATED("Footballer", this);
     }
 
     virtual ~Footballer() noexcept override {
-      if constexpr (Config::DEVELOPER_MODE && Config::CONFIDENTIAL_OVERRIDE) {
-        std::cout << "Footballer object destroyed: " << *this << '\n';
-      }
+      TRACE_OBJECT_DESTROYED("Footballer", this);
     }
 
     friend std::ostream& operator<<(std::ostream& os, const Footballer& footballer) {
       return os << static_cast<unsigned int>(footballer.m_age) << ", " << footballer.m_team;
     }
 
-    double ComputeEarnings() override {
-      return 100'000.0;
+    static constexpr double kEarnings{100'000.0};
+
+    double ComputeEarnings() const override {
+      return kEarnings;
     }
 
   private:
     std::string m_team;
+    InstanceTracker<Footballer> m_instance_tracker;
+};
+
+enum class PersonType : std::uint8_t {
+  Teacher,
+  Footballer
+};
+
+// One type's people as columns (no objects, no vtable). 'T::kEarnings' is the same for every person of
+// the type, so payroll is 'count * rate' and no column is read.
+template<typename T>
+class PersonColumns {
+  public:
+    void Reserve(std::size_t count) {
+      m_ages.reserve(count);
+      m_details.reserve(count);
+    }
+
+    void Add(Age age, std::string detail) {
+      m_ages.push_back(age);
+      m_details.push_back(std::move(detail));
+    }
+
+    double TotalEarnings() const { return TotalEarnings(m_ages.size()); }
+
+    void WriteRecords(output::Writer& out, std::string_view type_name) const {
+      for (std::size_t i{0}; i < m_ages.size(); ++i) {
+        WriteRecord(out, type_name, m_ages[i], m_details[i]);
+      }
+    }
+
+  // Column kernels, shared with 'PersonColumnsView' (the same columns in a snapshot mapping)
+    static double TotalEarnings(std::size_t count) {
+      return static_cast<double>(count) * T::kEarnings;
+    }
+
+    // One line 'Type: age, detail - Earnings: $...' or one CSV/binary record 'type, age, detail, earnings'.
+    static void WriteRecord(output::Writer& out, std::string_view type_name, Age age, std::string_view detail) {
+      if (out.GetFormat() == output::Format::Text) {
+        out << type_name << ": " << age << ", " << detail << " - Earnings: $" << T::kEarnings << '\n';
+      } else {
+        out.Record(type_name, age, detail, T::kEarnings);
+      }
+    }
+
+  // Getters
+    std::size_t Size() const noexcept { return m_ages.size(); }
+    const std::vector<Age>& Ages() const noexcept { return m_ages; }
+    const std::vector<std::string>& Details() const noexcept { return m_details; } // Profession, team, ...
+
+  private:
+    std::vector<Age> m_ages;
+    std::vector<std::string> m_details;
+};
+
+// Read-only 'PersonColumns' over a snapshot mapping: the details (one 'std::string' each in the store)
+// are packed into one character buffer, row 'i' ending at 'detail_ends[i]'.
+template<typename T>
+class PersonColumnsView {
+  public:
+    PersonColumnsView() = default;
+
+    PersonColumnsView(const Age* ages, const std::uint32_t* detail_ends, std::string_view characters, std::size_t count)
+        : m_ages(ages), m_detail_ends(detail_ends), m_characters(characters), m_count(count) {}
+
+    double TotalEarnings() const { return PersonColumns<T>::TotalEarnings(m_count); }
+
+    void WriteRecords(output::Writer& out, std::string_view type_name) const {
+      for (std::size_t i{0}; i < m_count; ++i) {
+        PersonColumns<T>::WriteRecord(out, type_name, m_ages[i], GetDetail(i));
+      }
+    }
+
+  // Getters
+    std::size_t Size() const noexcept { return m_count; }
+    const Age* Ages() const noexcept { return m_ages; }
+
+    // Unchecked: 'PeopleStoreView::Open' has already checked that every row lies inside the character buffer.
+    std::string_view GetDetail(std::size_t index) const noexcept {
+      const std::uint32_t begin{index ? m_detail_ends[index - 1] : 0};
+      return std::string_view(m_characters.data() + begin, m_detail_ends[index] - begin);
+    }
+
+  private:
+    const Age* m_ages{nullptr};
+    const std::uint32_t* m_detail_ends{nullptr};
+    std::string_view m_characters;
+    std::size_t m_count{0};
+};
+
+// A details column packed for a snapshot: the strings back to back, with each one's end offset.
+struct PackedDetails {
+  std::vector<std::uint32_t> ends;
+  std::string characters;
+};
+
+// 'std::nullopt' if the details add up to more than the 4 GiB that 32-bit offsets reach.
+static std::optional<PackedDetails> PackDetails(const std::vector<std::string>& details) {
+  PackedDetails packed;
+  packed.ends.reserve(details.size());
+  for (const std::string& detail : details) {
+    if (detail.size() > std::numeric_limits<std::uint32_t>::max() - packed.characters.size()) return std::nullopt;
+    packed.characters += detail;
+    packed.ends.push_back(static_cast<std::uint32_t>(packed.characters.size()));
+  }
+  return packed;
+}
+
+// Type-partitioned people for bulk payroll: a few passes over contiguous columns instead of one
+// virtual 'ComputeEarnings' call per 'std::unique_ptr<Person>'.
+class PeopleStore {
+  public:
+    static constexpr std::uint32_t kSnapshotKind{snapshot::Kind("PPLS")};
+
+    void AddTeacher(Age age, std::string profession) {
+      m_teachers.Add(age, std::move(profession));
+    }
+
+    void AddFootballer(Age age, std::string team) {
+      m_footballers.Add(age, std::move(team));
+    }
+
+    double TotalEarnings(PersonType type) const {
+      return type == PersonType::Teacher ? m_teachers.TotalEarnings() : m_footballers.TotalEarnings();
+    }
+
+    double TotalPayroll() const {
+      return m_teachers.TotalEarnings() + m_footballers.TotalEarnings();
+    }
+
+    // 0 for an empty store.
+    double AveragePayroll() const {
+      return Size() == 0 ? 0.0 : TotalPayroll() / static_cast<double>(Size());
+    }
+
+    // Payroll report: teachers, then footballers.
+    void WriteRecords(output::Writer& out) const {
+      out.Header({"type", "age", "detail", "earnings"});
+      m_teachers.WriteRecords(out, "Teacher");
+      m_footballers.WriteRecords(out, "Footballer");
+    }
+
+  // Getters
+    std::size_t Size() const noexcept {
+      return m_teachers.Size() + m_footballers.Size();
+    }
+
+    std::size_t Count(PersonType type) const noexcept {
+      return type == PersonType::Teacher ? m_teachers.Size() : m_footballers.Size();
+    }
+
+    const PersonColumns<Teacher>& GetTeachers() const noexcept {
+      return m_teachers;
+    }
+
+    const PersonColumns<Footballer>& GetFootballers() const noexcept {
+      return m_footballers;
+    }
+
+    // Ages, detail ends and detail characters of the teachers, then the same for the footballers, for
+    // 'PeopleStoreView'. The details are packed into one buffer per type first, the only copy made.
+    std::error_code SaveSnapshot(const std::string& path) const {
+      const std::optional<PackedDetails> professions{PackDetails(m_teachers.Details())};
+      const std::optional<PackedDetails> teams{PackDetails(m_footballers.Details())};
+      if (!professions || !teams) return std::make_error_code(std::errc::value_too_large);
+
+      return snapshot::Write(path, kSnapshotKind, Size(), {
+          snapshot::ColumnOf(m_teachers.Ages()), snapshot::ColumnOf(professions->ends), snapshot::ColumnOf(professions->characters),
+          snapshot::ColumnOf(m_footballers.Ages()), snapshot::ColumnOf(teams->ends), snapshot::ColumnOf(teams->characters)});
+    }
+
+  private:
+    PersonColumns<Teacher> m_teachers;
+    PersonColumns<Footballer> m_footballers;
+};
+
+// Read-only 'PeopleStore' served from a snapshot file ('PeopleStore::SaveSnapshot'), with the same
+// payroll and report methods: restarting on a saved store maps it instead of rebuilding every person.
+class PeopleStoreView {
+  public:
+    static std::variant<PeopleStoreView, std::error_code> Open(const std::string& path) {
+      auto opened = snapshot::MappedSnapshot::Open(path, PeopleStore::kSnapshotKind);
+      if (const auto* error = std::get_if<std::error_code>(&opened)) return *error;
+
+      PeopleStoreView view{std::move(std::get<snapshot::MappedSnapshot>(opened))};
+      const bool teachers{Map(view.m_snapshot, 0, view.m_teachers)};
+      const bool footballers{Map(view.m_snapshot, 3, view.m_footballers)};
+      if (!teachers || !footballers || view.Size() != view.m_snapshot.Rows()) {
+        return snapshot::make_error_code(snapshot::Error::BadColumn);
+      }
+      return view;
+    }
+
+    double TotalEarnings(PersonType type) const {
+      return type == PersonType::Teacher ? m_teachers.TotalEarnings() : m_footballers.TotalEarnings();
+    }
+
+    double TotalPayroll() const {
+      return m_teachers.TotalEarnings() + m_footballers.TotalEarnings();
+    }
+
+    // 0 for an empty store.
+    double AveragePayroll() const {
+      return Size() == 0 ? 0.0 : TotalPayroll() / static_cast<double>(Size());
+    }
+
+    void WriteRecords(output::Writer& out) const {
+      out.Header({"type", "age", "detail", "earnings"});
+      m_teachers.WriteRecords(out, "Teacher");
+      m_footballers.WriteRecords(out, "Footballer");
+    }
+
+  // Getters
+    std::size_t Size() const noexcept {
+      return m_teachers.Size() + m_footballers.Size();
+    }
+
+    std::size_t Count(PersonType type) const noexcept {
+      return type == PersonType::Teacher ? m_teachers.Size() : m_footballers.Size();
+    }
+
+    const PersonColumnsView<Teacher>& GetTeachers() const noexcept {
+      return m_teachers;
+    }
+
+    const PersonColumnsView<Footballer>& GetFootballers() const noexcept {
+      return m_footballers;
+    }
+
+  private:
+    explicit PeopleStoreView(snapshot::MappedSnapshot mapped) : m_snapshot(std::move(mapped)) {}
+
+    // Columns 'first' (ages), 'first + 1' (detail ends) and 'first + 2' (characters) of 'mapped'. The ends
+    // are checked once here (never decreasing, the last within the characters), so 'GetDetail' needs no check.
+    template<typename T>
+    static bool Map(const snapshot::MappedSnapshot& mapped, std::size_t first, PersonColumnsView<T>& out) {
+      const std::size_t count{mapped.Elements(first)};
+      const Age* ages{mapped.Column<Age>(first, count)};
+      const std::uint32_t* detail_ends{mapped.Column<std::uint32_t>(first + 1, count)};
+      const char* characters{mapped.Column<char>(first + 2, mapped.Elements(first + 2))};
+      if (!ages || !detail_ends || !characters) return false;
+
+      std::uint32_t previous_end{0};
+      for (std::size_t i{0}; i < count; ++i) {
+        if (detail_ends[i] < previous_end) return false;
+        previous_end = detail_ends[i];
+      }
+      if (previous_end > mapped.Elements(first + 2)) return false;
+
+      out = PersonColumnsView<T>(ages, detail_ends, std::string_view(characters, mapped.Elements(first + 2)), count);
+      return true;
+    }
+
+    snapshot::MappedSnapshot m_snapshot;
+    PersonColumnsView<Teacher> m_teachers;
+    PersonColumnsView<Footballer> m_footballers;
 };
 
 void CollectPeople(std::unique_ptr<Person>* people, std::size_t size) {
@@ -157,24 +496,233 @@ void CollectPeople(std::unique_ptr<Person>* people, std::size_t size) {
   }
 }
 
+template<typename T>
+void DisplayInstanceCounts(const char* name) {
+  const InstanceCounts counts{InstanceCounter<T>::Read()};
+  std::cout << "  " << name << ": " << counts.Live() << " live, " << counts.created << " created, "
+      << counts.destroyed << " destroyed\n";
+}
+
 void DisplayPersonInstances() {
-    std::cout << "Number of 'Person' instances: "
-        << static_cast<unsigned int>(Person::GetNumberOfInstances()) << '\n';
+    std::cout << "Number of 'Person' instances: " << Person::GetNumberOfInstances() << '\n';
+
+    if constexpr (Config::DEVELOPER_MODE) {
+      DisplayInstanceCounts<Person>("Person");
+      DisplayInstanceCounts<Teacher>("Teacher");
+      DisplayInstanceCounts<Footballer>("Footballer");
+    }
+}
+
+template<typename Number>
+std::optional<Number> ParseNumber(std::string_view field) {
+  Number value{};
+  const auto [end, error] = std::from_chars(field.data(), field.data() + field.size(), value);
+  if (error != std::errc() || end != field.data() + field.size()) return std::nullopt;
+  return value;
+}
+
+// One person per line, in the order of the interactive prompts: type (1 = Teacher, 2 = Footballer), age,
+// profession | team, separated by commas. Malformed lines are reported by line number and skipped.
+static PeopleStore ParsePeople(std::string_view text, std::size_t& malformed) {
+  PeopleStore store;
+  std::size_t line_number{0};
+
+  while (!text.empty()) {
+    const std::size_t newline{text.find('\n')};
+    std::string_view line{input::Trim(text.substr(0, newline))};
+    text.remove_prefix(newline == std::string_view::npos ? text.size() : newline + 1);
+    ++line_number;
+    if (line.empty()) continue;
+
+    std::string_view fields[3];
+    std::size_t count{0};
+    for (; count < 3 && !line.empty(); ++count) {
+      const std::size_t comma{line.find(',')};
+      fields[count] = input::Trim(line.substr(0, comma));
+      line.remove_prefix(comma == std::string_view::npos ? line.size() : comma + 1);
+    }
+
+    const unsigned int type{count == 3 && line.empty() ? ParseNumber<unsigned int>(fields[0]).value_or(0) : 0};
+    const auto age = ParseNumber<Age>(fields[1]);
+    if ((type != 1 && type != 2) || !age || fields[2].empty()) {
+      ++malformed;
+      std::cerr << "Line " << line_number << ": expected 'type,age,profession|team'; skipped.\n";
+      continue;
+    }
+
+    if (type == 1) {
+      store.AddTeacher(*age, std::string(fields[2]));
+    } else {
+      store.AddFootballer(*age, std::string(fields[2]));
+    }
+  }
+
+  return store;
+}
+
+// Usage: run.exe --save-snapshot <snapshot> [file|-] - reads people from 'file' (or standard input) into a
+// 'PeopleStore' and saves it for '--load-snapshot'.
+static int RunSaveSnapshotMode(const char* snapshot_path, const char* path) {
+  std::FILE* stream{path ? std::fopen(path, "rb") : stdin};
+  if (!stream) {
+    std::cerr << "Error: Cannot open '" << path << "'.\n";
+    return EXIT_FAILURE;
+  }
+
+  const std::string text{input::ReadAll(stream)};
+  if (path) std::fclose(stream);
+
+  std::size_t malformed{0};
+  const PeopleStore store{ParsePeople(text, malformed)};
+  if (const std::error_code error{store.SaveSnapshot(snapshot_path)}) {
+    std::cerr << "Error: Cannot write '" << snapshot_path << "': " << error.message() << '\n';
+    return EXIT_FAILURE;
+  }
+
+  std::cout << "Saved " << store.Size() << " people to '" << snapshot_path << "' (malformed lines: " << malformed << ")\n";
+  return malformed ? EXIT_FAILURE : EXIT_SUCCESS;
+}
+
+// Usage: run.exe --load-snapshot <snapshot> [text|csv|binary] - payroll report of a saved store, as text by
+// default. For CSV and binary the rows go to standard output and the totals to standard error.
+static int RunLoadSnapshotMode(const char* snapshot_path, output::Format format) {
+  auto opened = PeopleStoreView::Open(snapshot_path);
+  if (const auto* error = std::get_if<std::error_code>(&opened)) {
+    std::cerr << "Error: Cannot load '" << snapshot_path << "': " << error->message() << '\n';
+    return EXIT_FAILURE;
+  }
+  const PeopleStoreView& store{std::get<PeopleStoreView>(opened)};
+
+  {
+    output::Writer out{stdout, format};
+    store.WriteRecords(out);
+  } // Flushed here, before the totals
+
+  std::ostream& summary{format == output::Format::Text ? std::cout : std::cerr};
+  summary << "\nTotal payroll: $" << store.TotalPayroll() << " (people: " << store.Size() << ", average: $"
+      << store.AveragePayroll() << ", from snapshot)\n";
+  return EXIT_SUCCESS;
 }
 
-// Must be defined at file/global scope to make sure it has a unique memory location.
-MaxInstances Person::number_of_instances = 0;
+#if BENCHMARK_ENABLED
+// Usage: run.exe --benchmark [max_people] - payroll of random teachers and footballers through virtual
+// 'ComputeEarnings' calls and through 'PeopleStore::TotalPayroll' (O(1) while both rates are constant, so it
+// is timed per call), a CSV listing of the store's columns, the cost of building each and of saving and
+// mapping back a snapshot of the store, from 1K up to 'max_people' (1K, 10K, ...; default 10M). Every payroll
+// is checked against the others.
+static int RunPayrollBenchmark(std::size_t max_people) {
+  static const char* const kProfessions[]{"Mathematics", "Physics", "History", "Chemistry", "Literature"};
+  static const char* const kTeams[]{"Arsenal", "Barcelona", "Juventus", "Olympiacos", "Ajax"};
+  bench::Generator generator;
+  bench::PrintHeader();
+
+  for (std::size_t count : bench::Scales(max_people)) {
+    std::vector<bool> is_teacher(count);
+    std::vector<Age> ages(count);
+    std::vector<const char*> details(count);
+    for (std::size_t i{0}; i < count; ++i) {
+      is_teacher[i] = generator.Chance(0.9);
+      ages[i] = generator.Uniform<Age>(18, 70);
+      details[i] = is_teacher[i] ? generator.Pick(kProfessions) : generator.Pick(kTeams);
+    }
 
+    std::vector<std::unique_ptr<Person>> people;
+    PeopleStore store;
+    bench::Run("Build (std::make_unique)", count, [&] { people.clear(); }, [&] {
+      people.reserve(count);
+      for (std::size_t i{0}; i < count; ++i) {
+        if (is_teacher[i]) {
+          people.push_back(std::make_unique<Teacher>(ages[i], details[i]));
+        } else {
+          people.push_back(std::make_unique<Footballer>(ages[i], details[i]));
+        }
+      }
+    });
+    bench::Run("Build (PeopleStore)", count, [&] { store = PeopleStore(); }, [&] {
+      for (std::size_t i{0}; i < count; ++i) {
+        if (is_teacher[i]) {
+          store.AddTeacher(ages[i], details[i]);
+        } else {
+          store.AddFootballer(ages[i], details[i]);
+        }
+      }
+    });
+
+    double virtual_total{0.0}, store_total{0.0};
+    bench::Run("ComputeEarnings (virtual)", count, [&] {
+      virtual_total = 0.0;
+      for (const std::unique_ptr<Person>& person : people) virtual_total += person->ComputeEarnings();
+    });
+    bench::Run("PeopleStore::TotalPayroll (O(1))", 1, [&] { store_total = store.TotalPayroll(); });
+
+    // Every row of every column, with its earnings, through the buffered writer into the null device.
+    if (std::FILE* null_file{std::fopen(bench::kNullDevice, "wb")}) {
+      bench::Run("PeopleStore::WriteRecords (csv)", count, [&] {
+        output::Writer out{null_file, output::Format::Csv};
+        store.WriteRecords(out);
+      });
+      std::fclose(null_file);
+    }
+
+    // Restart: the store saved once and mapped back instead of rebuilt.
+    const std::string path{bench::TemporaryPath("people.snapshot")};
+    bench::Run("PeopleStore::SaveSnapshot", count, [&] { bench::DoNotOptimize(store.SaveSnapshot(path)); });
+    bench::Run("PeopleStoreView::Open", count, [&] { bench::DoNotOptimize(PeopleStoreView::Open(path).index()); });
+
+    auto opened = PeopleStoreView::Open(path);
+    const PeopleStoreView* view{std::get_if<PeopleStoreView>(&opened)};
+    const double view_total{view ? view->TotalPayroll() : 0.0};
+    const bool same_details{view && view->Size() == store.Size() &&
+                            view->GetTeachers().GetDetail(0) == store.GetTeachers().Details()[0]};
+    std::error_code ignored;
+    std::filesystem::remove(path, ignored);
+
+    if (virtual_total != store_total || view_total != store_total || !same_details) {
+      std::cerr << "Error: the payrolls disagree at " << count << " people (" << virtual_total << ", " << store_total
+                << ", " << view_total << ").\n";
+      return EXIT_FAILURE;
+    }
+  }
+
+  return EXIT_SUCCESS;
+}
+#endif // BENCHMARK_ENABLED
+
+
+int main(int argc, char* argv[]) {
+  if (argc > 2 && std::string_view(argv[1]) == "--save-snapshot") {
+    return RunSaveSnapshotMode(argv[2], argc > 3 && std::string_view(argv[3]) != "-" ? argv[3] : nullptr);
+  }
+
+  if (argc > 2 && std::string_view(argv[1]) == "--load-snapshot") {
+    const std::optional<output::Format> format{argc > 3 ? output::ParseFormat(argv[3]) : output::Format::Text};
+    if (!format) {
+      std::cerr << "Error: Unknown format '" << argv[3] << "' (expected text, csv or binary).\n";
+      return EXIT_FAILURE;
+    }
+    return RunLoadSnapshotMode(argv[2], *format);
+  }
+
+  if (argc > 1 && std::string_view(argv[1]) == "--benchmark") {
+    #if BENCHMARK_ENABLED
+      return RunPayrollBenchmark(bench::ParseCount(argc > 2 ? argv[2] : nullptr, 10'000'000));
+    #else
+      std::cerr << "Error: '--benchmark' needs a build with -DENABLE_BENCHMARK.\n";
+      return EXIT_FAILURE;
+    #endif // BENCHMARK_ENABLED
+  }
 
-int main() {
   constexpr MaxInstances kNumberOfPeople{5};
   std::unique_ptr<Person> people[kNumberOfPeople];
 
   CollectPeople(people, kNumberOfPeople);
 
-  std::cout << "\nSummary of people:\n";
-  for (std::size_t i{0}; i < kNumberOfPeople; ++i) {
-    std::cout << *people[i] << " - Earnings: $" << people[i]->ComputeEarnings() << '\n';
+  {
+    output::Writer out{stdout, output::Format::Text, 4'096};
+    out << "\nSummary of people:\n";
+    for (std::size_t i{0}; i < kNumberOfPeople; ++i) {
+      WriteRecord(out, *people[i]);
+    }
   }
 
   DisplayPersonInstances();
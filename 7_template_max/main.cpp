@@ -2,17 +2,82 @@
 // This program calculates the max of 3 numbers or strings (lexicographically).
 
 #include <iostream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include "../common/bench.h" // '--benchmark' harness and data generators; compiled out unless -DENABLE_BENCHMARK
+#include "../common/reduce.h" // 'maxN', 'max_of' and 'argmax' (SIMD with -mavx2, parallel for large ranges)
 
+// By reference: comparing strings does not copy them. With temporaries as arguments (literals, or a
+// 'std::string' built from one) the result is only valid until the end of the full expression.
 template<typename T>
-T max3(T first, T second, T third) {
-  return (first > second ? (first > third) ? first : third : second);
+const T& max3(const T& first, const T& second, const T& third) {
+  return reduce::maxN(first, second, third);
 }
 
+#if BENCHMARK_ENABLED
+// Usage: run.exe --benchmark [max_values] - 'max3', 'maxN', 'max_of' and 'argmax' over random doubles,
+// 32-bit sizes and strings, from 1K up to 'max_values' (1K, 10K, ...; default 10M).
+static int RunMaxBenchmark(std::size_t max_values) {
+  bench::Generator generator;
+  bench::PrintHeader();
 
-int main() {
+  for (std::size_t count : bench::Scales(max_values)) {
+    std::vector<double> volumes(count);
+    std::vector<std::uint32_t> sizes(count);
+    for (double& volume : volumes) volume = generator.UniformReal(0.0, 4.5e18); // Up to the largest sphere
+    for (std::uint32_t& size : sizes) size = generator.Uniform<std::uint32_t>(0, 4'000'000'000);
+    std::vector<std::string> words(std::min<std::size_t>(count, 10'000'000)); // ~40 bytes each
+    for (std::string& word : words) word = generator.Word(4, 24); // Mostly past the small-string buffer
+
+    const std::size_t triples{count / 3};
+    bench::Run("max3 (double)", triples * 3, [&] {
+      double sum{0.0};
+      for (std::size_t i{0}; i < triples; ++i) sum += max3(volumes[3 * i], volumes[3 * i + 1], volumes[3 * i + 2]);
+      bench::DoNotOptimize(sum);
+    });
+    bench::Run("max3 (std::string)", words.size() / 3 * 3, [&] {
+      std::size_t length{0};
+      for (std::size_t i{0}; i + 3 <= words.size(); i += 3) length += max3(words[i], words[i + 1], words[i + 2]).size();
+      bench::DoNotOptimize(length);
+    });
+    bench::Run("maxN (double, 6 arguments)", count / 6 * 6, [&] {
+      double sum{0.0};
+      for (std::size_t i{0}; i + 6 <= count; i += 6) {
+        sum += reduce::maxN(volumes[i], volumes[i + 1], volumes[i + 2], volumes[i + 3], volumes[i + 4], volumes[i + 5]);
+      }
+      bench::DoNotOptimize(sum);
+    });
+    bench::Run("max_of (double)", count, [&] { bench::DoNotOptimize(reduce::max_of(volumes)); });
+    bench::Run("max_of (uint32_t)", count, [&] { bench::DoNotOptimize(reduce::max_of(sizes)); });
+    bench::Run("argmax (std::string)", words.size(), [&] { bench::DoNotOptimize(reduce::argmax(words)); });
+  }
+
+  return EXIT_SUCCESS;
+}
+#endif // BENCHMARK_ENABLED
+
+
+int main(int argc, char* argv[]) {
+  if (argc > 1 && std::string_view(argv[1]) == "--benchmark") {
+    #if BENCHMARK_ENABLED
+      return RunMaxBenchmark(bench::ParseCount(argc > 2 ? argv[2] : nullptr, 10'000'000));
+    #else
+      std::cerr << "Error: '--benchmark' needs a build with -DENABLE_BENCHMARK.\n";
+      return EXIT_FAILURE;
+    #endif // BENCHMARK_ENABLED
+  }
 
   std::cout << max3<double>(3.14, 2.72, 1.62) << '\n';
   std::cout << max3<std::string>("pi", "epsilon", "phi") << '\n';
 
+  const std::vector<double> constants{3.14, 2.72, 1.62, 1.41, 2.50};
+  std::cout << reduce::maxN(3.14, 2.72, 1.62, 1.41) << '\n';
+  std::cout << reduce::max_of(constants) << " at index " << reduce::argmax(constants) << '\n';
+
   return 0;
 }
@@ -0,0 +1,281 @@
+// bench.h
+// Shared benchmark harness for the exercises' '--benchmark' modes: each case is repeated until it has
+// run long enough to time, and reported as throughput, ns per item and heap allocations per item.
+// 'bench::Generator' produces the synthetic inputs from a fixed seed, so every run (on every standard
+// library) measures the same data and the numbers can be compared between commits.
+//
+// Usage (from any exercise): #include "../common/bench.h"
+//   bench::Generator generator;                             // Same sequence on every run
+//   bench::PrintHeader();
+//   for (std::size_t count : bench::Scales(max_items)) {     // 1K, 10K, ... up to 'max_items'
+//     const std::vector<double> radii{...};
+//     bench::Run("CalculateVolumes", count, [&] { bench::DoNotOptimize(...); });
+//   }
+// <!> Compiled out unless built with -DENABLE_BENCHMARK: the header is then empty, so guard the
+// '--benchmark' modes with '#if BENCHMARK_ENABLED'.
+// <!> Replaces the global 'operator new'/'operator delete' to count allocations, so include it from
+// exactly one translation unit per program (each exercise is a single 'main.cpp'). The counter is one
+// shared atomic, which is why normal builds leave the allocation functions alone.
+
+#ifndef COMMON_BENCH_H
+#define COMMON_BENCH_H
+
+#if defined(ENABLE_BENCHMARK)
+  #define BENCHMARK_ENABLED 1
+#else
+  #define BENCHMARK_ENABLED 0
+#endif // ENABLE_BENCHMARK
+
+#if BENCHMARK_ENABLED
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <filesystem>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#if defined(_MSC_VER)
+  #include <malloc.h> // '_aligned_malloc'
+#endif // _MSC_VER
+
+namespace bench {
+  // Every case runs for at least this long (and at least once); large inputs get a single iteration.
+  constexpr double kMinSeconds{0.2};
+  constexpr std::uint64_t kMaxIterations{1'000'000};
+
+  // Seed of every 'Generator' unless given another one.
+  constexpr std::uint64_t kSeed{42};
+
+  // Sink for output benchmarks: everything written there is discarded by the OS.
+  #if defined(_WIN32)
+    constexpr const char* kNullDevice{"NUL"};
+  #else
+    constexpr const char* kNullDevice{"/dev/null"};
+  #endif // _WIN32
+
+  // Scratch file for cases that go through the disk (snapshots, ...), in the system's temporary directory.
+  inline std::string TemporaryPath(std::string_view name) {
+    return (std::filesystem::temp_directory_path() / name).string();
+  }
+
+  inline std::atomic<std::uint64_t> s_allocations{0};
+
+  // Heap allocations made so far by the whole program (every thread).
+  inline std::uint64_t Allocations() noexcept {
+    return s_allocations.load(std::memory_order_relaxed);
+  }
+
+  // Keeps 'value' (and the work that produced it) from being optimized away.
+  template<typename T>
+  inline void DoNotOptimize(const T& value) {
+    #if defined(__GNUC__)
+      asm volatile("" : : "r,m"(value) : "memory");
+    #else
+      static volatile const void* sink;
+      sink = &value;
+    #endif // __GNUC__
+  }
+
+  // 'std::mt19937_64' is specified bit for bit, but the standard distributions are not, so the
+  // ranges are mapped here to keep the data identical across compilers. The modulo bias is
+  // negligible for the small ranges the generators use.
+  class Generator {
+    public:
+      explicit Generator(std::uint64_t seed = kSeed) : m_engine(seed) {}
+
+      // Uniform integer in [low, high].
+      template<typename T>
+      T Uniform(T low, T high) {
+        const std::uint64_t span{static_cast<std::uint64_t>(high) - static_cast<std::uint64_t>(low) + 1};
+        return static_cast<T>(static_cast<std::uint64_t>(low) + (span == 0 ? m_engine() : m_engine() % span));
+      }
+
+      // Uniform real in [low, high).
+      double UniformReal(double low, double high) {
+        const double unit{static_cast<double>(m_engine() >> 11) * 0x1.0p-53}; // 53 random mantissa bits
+        return low + unit * (high - low);
+      }
+
+      bool Chance(double probability) { return UniformReal(0.0, 1.0) < probability; }
+
+      // Capitalized lowercase word, e.g. a name, street or city.
+      std::string Word(std::size_t min_length, std::size_t max_length) {
+        std::string word(Uniform(min_length, max_length), 'a');
+        for (char& letter : word) letter = static_cast<char>('a' + Uniform(0, 25));
+        if (!word.empty()) word[0] = static_cast<char>(word[0] - 'a' + 'A');
+        return word;
+      }
+
+      template<typename T, std::size_t N>
+      const T& Pick(const T (&values)[N]) { return values[Uniform<std::size_t>(0, N - 1)]; }
+
+      std::uint64_t operator()() { return m_engine(); }
+
+    private:
+      std::mt19937_64 m_engine;
+  };
+
+  // "100000", "100K", "10M" or "1G" (powers of ten); 'fallback' when absent or unreadable.
+  inline std::size_t ParseCount(const char* text, std::size_t fallback) {
+    if (!text) return fallback;
+
+    char* end{nullptr};
+    const unsigned long long value{std::strtoull(text, &end, 10)};
+    if (end == text) return fallback;
+
+    switch (*end) {
+      case 'k': case 'K': return static_cast<std::size_t>(value * 1'000ULL);
+      case 'm': case 'M': return static_cast<std::size_t>(value * 1'000'000ULL);
+      case 'g': case 'G': return static_cast<std::size_t>(value * 1'000'000'000ULL);
+      default: return static_cast<std::size_t>(value);
+    }
+  }
+
+  // 1K, 10K, 100K, ... up to 'max_items' (or just 'max_items' if it is below 1K).
+  inline std::vector<std::size_t> Scales(std::size_t max_items) {
+    std::vector<std::size_t> scales;
+    for (std::size_t count{1'000}; count <= max_items; count *= 10) {
+      scales.push_back(count);
+      if (count > max_items / 10) break; // Next step would overflow or exceed 'max_items'
+    }
+    if (scales.empty() && max_items) scales.push_back(max_items);
+    return scales;
+  }
+
+  struct Result {
+    std::size_t items{0};             // Per iteration
+    std::uint64_t iterations{0};
+    double seconds{0.0};              // Timed total over all iterations
+    std::uint64_t allocations{0};     // Timed total over all iterations
+
+    double NanosecondsPerItem() const { return seconds * 1e9 / (static_cast<double>(items) * static_cast<double>(iterations)); }
+    double ItemsPerSecond() const { return static_cast<double>(items) * static_cast<double>(iterations) / seconds; }
+    double AllocationsPerItem() const {
+      return static_cast<double>(allocations) / (static_cast<double>(items) * static_cast<double>(iterations));
+    }
+  };
+
+  inline void PrintHeader() {
+    std::cout << std::left << std::setw(36) << "Benchmark" << std::setw(13) << "Items" << std::setw(12) << "Iterations"
+              << std::setw(12) << "ns/item" << std::setw(14) << "Items/s" << "Allocs/item\n";
+  }
+
+  inline void Print(std::string_view name, const Result& result) {
+    const std::ios_base::fmtflags flags{std::cout.flags()};
+    const std::streamsize precision{std::cout.precision()};
+
+    std::cout << std::left << std::setw(36) << name << std::setw(13) << result.items << std::setw(12) << result.iterations
+              << std::fixed << std::setprecision(3) << std::setw(12) << result.NanosecondsPerItem()
+              << std::scientific << std::setprecision(3) << std::setw(14) << result.ItemsPerSecond()
+              << std::fixed << std::setprecision(3) << result.AllocationsPerItem() << '\n';
+
+    std::cout.flags(flags);
+    std::cout.precision(precision);
+  }
+
+  // Times 'body' over 'items' items; 'setup' runs untimed before every iteration (e.g. to restore
+  // the input that 'body' sorts in place). Allocations are counted while 'body' runs only.
+  template<typename Setup, typename Body>
+  Result Run(std::string_view name, std::size_t items, Setup&& setup, Body&& body) {
+    Result result;
+    result.items = items ? items : 1;
+
+    while (result.iterations == 0 || (result.seconds < kMinSeconds && result.iterations < kMaxIterations)) {
+      setup();
+
+      const std::uint64_t allocations{Allocations()};
+      const auto start = std::chrono::steady_clock::now();
+      body();
+      const auto stop = std::chrono::steady_clock::now();
+
+      result.allocations += Allocations() - allocations;
+      result.seconds += std::chrono::duration<double>(stop - start).count();
+      ++result.iterations;
+    }
+
+    Print(name, result);
+    return result;
+  }
+
+  template<typename Body>
+  Result Run(std::string_view name, std::size_t items, Body&& body) {
+    return Run(name, items, [] {}, body);
+  }
+}
+
+// Counting replacements of the global allocation functions, in every form so each allocation is made
+// and freed by the same pair, whatever the runtime forwards by default. The aligned forms matter too:
+// 'std::pmr::new_delete_resource' (the default 'std::pmr' upstream) uses them.
+// GCC cannot tell that this 'operator new' is 'std::malloc', so it flags the matching 'std::free'.
+#if defined(__GNUC__) && !defined(__clang__)
+  #pragma GCC diagnostic push
+  #pragma GCC diagnostic ignored "-Wmismatched-new-delete"
+#endif // __GNUC__
+
+void* operator new(std::size_t size) {
+  bench::s_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void* memory = std::malloc(size ? size : 1)) return memory;
+  throw std::bad_alloc();
+}
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  bench::s_allocations.fetch_add(1, std::memory_order_relaxed);
+  const auto align = static_cast<std::size_t>(alignment);
+  const std::size_t rounded{(size + align - 1) / align * align}; // 'std::aligned_alloc' wants a multiple
+  #if defined(_MSC_VER)
+    if (void* memory = _aligned_malloc(rounded ? rounded : align, align)) return memory;
+  #else
+    if (void* memory = std::aligned_alloc(align, rounded ? rounded : align)) return memory;
+  #endif // _MSC_VER
+  throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) { return ::operator new(size); }
+void* operator new[](std::size_t size, std::align_val_t alignment) { return ::operator new(size, alignment); }
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+  try { return ::operator new(size); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+  try { return ::operator new(size); } catch (...) { return nullptr; }
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  try { return ::operator new(size, alignment); } catch (...) { return nullptr; }
+}
+void* operator new[](std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  try { return ::operator new(size, alignment); } catch (...) { return nullptr; }
+}
+
+void operator delete(void* memory) noexcept { std::free(memory); }
+void operator delete[](void* memory) noexcept { std::free(memory); }
+void operator delete(void* memory, std::size_t) noexcept { std::free(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { std::free(memory); }
+
+#if defined(_MSC_VER)
+  void operator delete(void* memory, std::align_val_t) noexcept { _aligned_free(memory); }
+#else
+  void operator delete(void* memory, std::align_val_t) noexcept { std::free(memory); }
+#endif // _MSC_VER
+void operator delete[](void* memory, std::align_val_t alignment) noexcept { ::operator delete(memory, alignment); }
+void operator delete(void* memory, std::size_t, std::align_val_t alignment) noexcept { ::operator delete(memory, alignment); }
+void operator delete[](void* memory, std::size_t, std::align_val_t alignment) noexcept { ::operator delete(memory, alignment); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { ::operator delete(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { ::operator delete(memory); }
+void operator delete(void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept { ::operator delete(memory, alignment); }
+void operator delete[](void* memory, std::align_val_t alignment, const std::nothrow_t&) noexcept { ::operator delete(memory, alignment); }
+
+#if defined(__GNUC__) && !defined(__clang__)
+  #pragma GCC diagnostic pop
+#endif // __GNUC__
+
+#endif // BENCHMARK_ENABLED
+
+#endif // COMMON_BENCH_H
@@ -0,0 +1,46 @@
+// input.h
+// Bulk (non-interactive) input for the exercises: the whole stream is read in large blocks and then
+// parsed in place with 'std::from_chars', instead of one 'std::cin >>' extraction (and 'ignore'/'clear'
+// recovery) per value.
+//
+// Usage (from any exercise): #include "../common/input.h"
+//   const std::string text{input::ReadAll(stdin)};
+//   std::string_view line{input::Trim(text.substr(0, text.find('\n')))};
+// The views returned by 'Trim' point into 'text', so they are only valid while it is alive.
+
+#ifndef COMMON_INPUT_H
+#define COMMON_INPUT_H
+
+#include <cstddef>
+#include <cstdio>
+#include <string>
+#include <string_view>
+
+namespace input {
+  // Reads 'stream' to the end in 1 MiB blocks; a read error ends the data early like end of file.
+  inline std::string ReadAll(std::FILE* stream) {
+    constexpr std::size_t kChunk{1 << 20};
+    std::string data;
+    std::size_t size{0};
+
+    for (;;) {
+      data.resize(size + kChunk);
+      const std::size_t read{std::fread(&data[size], 1, kChunk, stream)};
+      size += read;
+      if (read < kChunk) break;
+    }
+
+    data.resize(size);
+    return data;
+  }
+
+  // Strips spaces, tabs and the '\r' of Windows line endings from both ends.
+  inline std::string_view Trim(std::string_view text) {
+    constexpr std::string_view kWhitespace{" \t\r"};
+    const std::size_t first{text.find_first_not_of(kWhitespace)};
+    if (first == std::string_view::npos) return {};
+    return text.substr(first, text.find_last_not_of(kWhitespace) - first + 1);
+  }
+}
+
+#endif // COMMON_INPUT_H
@@ -0,0 +1,197 @@
+// output.h
+// Buffered bulk output for the exercises' reports. Records are formatted straight into one large
+// reusable buffer with 'std::to_chars', which skips locales, virtual calls and 'std::to_string'
+// temporaries, and the buffer goes out in a single 'std::fwrite' each time it fills up.
+//
+// Usage (from any exercise): #include "../common/output.h"
+//   output::Writer out{stdout, output::Format::Csv};
+//   out.Header({"radius", "volume"});       // CSV only; ignored for the other formats
+//   for (const Sphere& sphere : spheres) WriteRecord(out, sphere);
+//
+// Each type provides 'WriteRecord(output::Writer&, const T&)'. In 'Format::Text' it writes the same line
+// as its 'operator<<'. In the other formats it writes one 'Record' of its fields:
+//   Csv    - comma-separated, RFC 4180 quoting; floating-point values in shortest round-trip form.
+//   Binary - fixed-width fields in host byte order; strings as a 32-bit length then the bytes.
+// Text matches 'std::ostream' defaults (6 significant digits), except that numbers ignore the locale and
+// single-byte integers ('std::uint8_t', ...) print as numbers, not characters.
+// <!> Flush before writing to the same file through another stream ('std::cout' on 'stdout', ...).
+
+#ifndef COMMON_OUTPUT_H
+#define COMMON_OUTPUT_H
+
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <initializer_list>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <system_error>
+#include <type_traits>
+
+#if defined(_WIN32)
+  #include <fcntl.h>
+  #include <io.h>
+#endif // _WIN32
+
+namespace output {
+  enum class Format : std::uint8_t {
+    Text,
+    Csv,
+    Binary
+  };
+
+  // "text", "csv" or "binary"; 'std::nullopt' for anything else.
+  inline std::optional<Format> ParseFormat(std::string_view name) {
+    if (name == "text") return Format::Text;
+    if (name == "csv") return Format::Csv;
+    if (name == "binary") return Format::Binary;
+    return std::nullopt;
+  }
+
+  class Writer {
+    public:
+      static constexpr std::size_t kDefaultCapacity{1 << 20}; // 1 MiB per 'std::fwrite'
+
+      explicit Writer(std::FILE* file, Format format = Format::Text, std::size_t capacity = kDefaultCapacity)
+          : m_file(file), m_format(format), m_capacity(capacity < kMaxNumberLength ? kMaxNumberLength : capacity),
+            m_buffer(new char[m_capacity]) { // Uninitialized: 'std::make_unique<char[]>' would zero it
+        #if defined(_WIN32)
+          // Text-mode streams would turn every 0x0A byte into "\r\n".
+          if (m_format == Format::Binary) _setmode(_fileno(m_file), _O_BINARY);
+        #endif // _WIN32
+      }
+
+      Writer(const Writer&) = delete;
+      Writer& operator=(const Writer&) = delete;
+
+      ~Writer() { Flush(); }
+
+      Format GetFormat() const noexcept { return m_format; }
+
+      // Hands the buffered bytes to the file; false if any write so far has failed.
+      bool Flush() {
+        if (m_size && std::fwrite(m_buffer.get(), 1, m_size, m_file) != m_size) m_failed = true;
+        m_size = 0;
+        return !m_failed;
+      }
+
+    // Text
+      Writer& operator<<(std::string_view text) {
+        Append(text.data(), text.size());
+        return *this;
+      }
+
+      Writer& operator<<(char character) {
+        if (m_size == m_capacity) Flush();
+        m_buffer[m_size++] = character;
+        return *this;
+      }
+
+      template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T> && !std::is_same_v<T, char>>>
+      Writer& operator<<(T value) {
+        Number(value, false);
+        return *this;
+      }
+
+    // Records
+      // CSV column names; nothing is written for the other formats.
+      void Header(std::initializer_list<std::string_view> names) {
+        if (m_format != Format::Csv) return;
+
+        bool first{true};
+        for (std::string_view name : names) {
+          if (!first) *this << ',';
+          first = false;
+          Field(name);
+        }
+        *this << '\n';
+      }
+
+      // One record of 'fields' (strings and numbers) in the writer's format; in 'Format::Text' the fields
+      // are separated by ", ".
+      template<typename... Fields>
+      void Record(const Fields&... fields) {
+        std::size_t index{0};
+        ((Separator(index++), Field(fields)), ...);
+        if (m_format != Format::Binary) *this << '\n';
+      }
+
+    private:
+      static constexpr std::size_t kMaxNumberLength{32}; // "-1.7976931348623157e+308" and every integer fit
+
+      void Append(const char* data, std::size_t size) {
+        if (size > m_capacity - m_size) {
+          Flush();
+          if (size > m_capacity) { // Too big to buffer: write it through
+            if (std::fwrite(data, 1, size, m_file) != size) m_failed = true;
+            return;
+          }
+        }
+        std::memcpy(m_buffer.get() + m_size, data, size);
+        m_size += size;
+      }
+
+      template<typename T>
+      void Number(T value, bool round_trip) {
+        if (m_capacity - m_size < kMaxNumberLength) Flush();
+        char* first{m_buffer.get() + m_size};
+        char* last{m_buffer.get() + m_capacity};
+
+        std::to_chars_result result;
+        if constexpr (std::is_same_v<T, bool>) {
+          result = std::to_chars(first, last, static_cast<unsigned int>(value));
+        } else if constexpr (std::is_floating_point_v<T>) {
+          // 'std::ostream' prints floating-point values like '%g' with 6 digits.
+          result = round_trip ? std::to_chars(first, last, value) : std::to_chars(first, last, value, std::chars_format::general, 6);
+        } else {
+          result = std::to_chars(first, last, value);
+        }
+        m_size = static_cast<std::size_t>(result.ptr - m_buffer.get());
+      }
+
+      void Separator(std::size_t index) {
+        if (index == 0 || m_format == Format::Binary) return;
+        if (m_format == Format::Csv) *this << ',';
+        else *this << ", ";
+      }
+
+      void Field(std::string_view text) {
+        if (m_format == Format::Binary) {
+          const auto length = static_cast<std::uint32_t>(text.size());
+          Append(reinterpret_cast<const char*>(&length), sizeof(length));
+          Append(text.data(), length);
+        } else if (m_format == Format::Csv && text.find_first_of(",\"\r\n") != std::string_view::npos) {
+          *this << '"';
+          for (std::size_t quote; (quote = text.find('"')) != std::string_view::npos; text.remove_prefix(quote + 1)) {
+            *this << text.substr(0, quote + 1) << '"'; // Quotes inside are doubled
+          }
+          *this << text << '"';
+        } else {
+          *this << text;
+        }
+      }
+
+      template<typename T, typename = std::enable_if_t<std::is_arithmetic_v<T>>>
+      void Field(T value) {
+        if (m_format == Format::Binary) {
+          Append(reinterpret_cast<const char*>(&value), sizeof(value));
+        } else if constexpr (std::is_same_v<T, char>) {
+          Field(std::string_view(&value, 1));
+        } else {
+          Number(value, m_format == Format::Csv);
+        }
+      }
+
+      std::FILE* m_file;
+      Format m_format;
+      std::size_t m_capacity;
+      std::unique_ptr<char[]> m_buffer;
+      std::size_t m_size{0};
+      bool m_failed{false};
+  };
+}
+
+#endif // COMMON_OUTPUT_H
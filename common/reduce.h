@@ -0,0 +1,307 @@
+// reduce.h
+// Shared reducers for the exercises' columns (volumes, image sizes, taxes, ...), and the slicing
+// helper their parallel kernels split work with.
+// - 'maxN': largest of any number of arguments, by reference;
+// - 'max_of' / 'argmax': largest element of a range and its position. Contiguous arithmetic ranges get
+//   an AVX2 horizontal max (build with '-mavx2') and, when large, a split across threads;
+// - 'ForEachSlice' / 'MapSlices': runs a kernel over contiguous slices of [0, count) on a persistent pool
+//   of worker threads ('WorkerPool'), one slice per thread.
+//
+// Usage (from any exercise): #include "../common/reduce.h"
+//   const double largest{reduce::max_of(volumes)};           // 'volumes' must not be empty
+//   const std::size_t first{reduce::argmax(sizes)};
+//   const std::vector<TotalTax> partials{reduce::MapSlices<TotalTax>(count, 1 << 16, [&](std::size_t begin, std::size_t end) {
+//     return CalculateTotalTax(vehicles + begin, end - begin);
+//   })};
+// NaNs in arithmetic ranges are skipped: 'max_of' is NaN and 'argmax' 0 only when every value is NaN.
+// Other element types are compared with 'operator>' alone.
+
+#ifndef COMMON_REDUCE_H
+#define COMMON_REDUCE_H
+
+#include <algorithm>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <iterator>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#if defined(__AVX2__)
+  #include <immintrin.h>
+#endif // __AVX2__
+
+namespace reduce {
+  // Smallest slice of a range worth handing to its own thread in 'max_of' / 'argmax'.
+  constexpr std::size_t kMinElementsPerWorker{1 << 18};
+
+  // Slices 'ForEachSlice' makes of 'count' elements: one per hardware thread, but none smaller than
+  // 'min_per_slice' (so small inputs stay on the calling thread), and always at least one.
+  inline std::size_t SliceCount(std::size_t count, std::size_t min_per_slice) {
+    const std::size_t hardware_threads{std::max<std::size_t>(1, std::thread::hardware_concurrency())};
+    return std::clamp<std::size_t>(count / std::max<std::size_t>(min_per_slice, 1), 1, hardware_threads);
+  }
+
+  // 'hardware_concurrency() - 1' threads started on first use and kept until exit, so a parallel kernel
+  // called over and over (one batch of rows, one statistics pass, ...) does not pay for thread creation
+  // each time. 'Run' hands tasks to the workers and has the calling thread run queued tasks too while it
+  // waits, so nested or concurrent 'Run' calls cannot deadlock (and a one-core machine needs no worker).
+  class WorkerPool {
+    public:
+      static WorkerPool& Instance() {
+        static WorkerPool pool(std::max(1U, std::thread::hardware_concurrency()) - 1);
+        return pool;
+      }
+
+      WorkerPool(const WorkerPool&) = delete;
+      WorkerPool& operator=(const WorkerPool&) = delete;
+
+      ~WorkerPool() {
+        {
+          std::lock_guard<std::mutex> lock{m_mutex};
+          m_stopping = true;
+        }
+        m_wake.notify_all();
+        for (std::thread& worker : m_workers) worker.join();
+      }
+
+      // Calls 'task(i)' for every i in [0, tasks): i = 0 on the calling thread, the rest on any thread.
+      // Returns once all of them are done.
+      template<typename Task>
+      void Run(std::size_t tasks, const Task& task) {
+        std::size_t remaining{tasks};
+        {
+          std::lock_guard<std::mutex> lock{m_mutex};
+          for (std::size_t i{1}; i < tasks; ++i) {
+            m_queue.push_back([this, &task, &remaining, i] {
+              task(i);
+              std::lock_guard<std::mutex> done{m_mutex};
+              if (--remaining == 0) m_done.notify_all();
+            });
+          }
+        }
+        m_wake.notify_all();
+
+        task(std::size_t{0});
+        std::unique_lock<std::mutex> lock{m_mutex};
+        --remaining;
+        while (remaining != 0) {
+          if (m_queue.empty()) {
+            m_done.wait(lock);
+            continue;
+          }
+          std::function<void()> queued{std::move(m_queue.front())};
+          m_queue.pop_front();
+          lock.unlock();
+          queued();
+          lock.lock();
+        }
+      }
+
+    private:
+      explicit WorkerPool(unsigned int workers) {
+        m_workers.reserve(workers);
+        for (unsigned int i{0}; i < workers; ++i) {
+          m_workers.emplace_back([this] { WorkLoop(); });
+        }
+      }
+
+      void WorkLoop() {
+        std::unique_lock<std::mutex> lock{m_mutex};
+        for (;;) {
+          m_wake.wait(lock, [this] { return m_stopping || !m_queue.empty(); });
+          if (m_queue.empty()) return; // Stopping, and nothing left to run
+
+          std::function<void()> task{std::move(m_queue.front())};
+          m_queue.pop_front();
+          lock.unlock();
+          task();
+          lock.lock();
+        }
+      }
+
+      std::mutex m_mutex;
+      std::condition_variable m_wake; // Tasks queued, or stopping
+      std::condition_variable m_done; // A 'Run' may have finished
+      std::deque<std::function<void()>> m_queue;
+      std::vector<std::thread> m_workers;
+      bool m_stopping{false};
+  };
+
+  // Calls 'work(slice, begin, end)' for each of the 'SliceCount' contiguous slices of [0, count) on the
+  // 'WorkerPool'; the calling thread takes slice 0, and the call returns once every slice is done.
+  // Trailing slices may be empty ('begin == end'). 'work' must only write to its own slice's output.
+  template<typename Work>
+  void ForEachSlice(std::size_t count, std::size_t min_per_slice, const Work& work) {
+    const std::size_t slices{SliceCount(count, min_per_slice)};
+    const std::size_t chunk{(count + slices - 1) / slices};
+    if (slices == 1) { // Small input: skip the pool
+      work(std::size_t{0}, std::size_t{0}, count);
+      return;
+    }
+
+    WorkerPool::Instance().Run(slices, [&work, count, chunk](std::size_t slice) {
+      const std::size_t begin{std::min(count, slice * chunk)};
+      work(slice, begin, std::min(count, begin + chunk));
+    });
+  }
+
+  // 'work(begin, end)' of every slice, in slice order; merge them on the calling thread.
+  template<typename Result, typename Work>
+  std::vector<Result> MapSlices(std::size_t count, std::size_t min_per_slice, const Work& work) {
+    std::vector<Result> results(SliceCount(count, min_per_slice));
+    ForEachSlice(count, min_per_slice, [&results, &work](std::size_t slice, std::size_t begin, std::size_t end) {
+      results[slice] = work(begin, end);
+    });
+    return results;
+  }
+
+  template<typename T>
+  constexpr bool IsMutableLvalue = std::is_lvalue_reference_v<T> && !std::is_const_v<std::remove_reference_t<T>>;
+
+  // Largest of any number of arguments of one type, returned by reference; ties keep the earliest.
+  // 'T&' if every argument is a non-const lvalue (so the winner can be modified in place), else 'const T&'.
+  template<typename First, typename... Rest>
+  constexpr decltype(auto) maxN(First&& first, Rest&&... rest) {
+    using Value = std::remove_cv_t<std::remove_reference_t<First>>;
+    static_assert((std::is_same_v<Value, std::remove_cv_t<std::remove_reference_t<Rest>>> && ...),
+                  "'maxN' compares arguments of one type");
+
+    using Pointer = std::conditional_t<IsMutableLvalue<First&&> && (IsMutableLvalue<Rest&&> && ...), Value*, const Value*>;
+    Pointer best{&first};
+    ((best = rest > *best ? Pointer{&rest} : best), ...);
+    return *best;
+  }
+
+  // Horizontal max of 'count' > 0 values, skipping NaNs (NaN only if every value is NaN). AVX2 has a
+  // lane-wise max for these four types; the others (and the tail) go through the scalar loop. The lanes
+  // start from the first non-NaN value, and '_mm256_max_p*' returns its second operand when either is
+  // NaN, so a NaN never enters them.
+  template<typename T>
+  T MaxValue(const T* values, std::size_t count) {
+    std::size_t i{0};
+    if constexpr (std::is_floating_point_v<T>) {
+      while (i < count && values[i] != values[i]) ++i; // Leading NaNs
+      if (i == count) return values[0];
+    }
+    T best{values[i]};
+
+    #if defined(__AVX2__)
+      if constexpr (std::is_same_v<T, double>) {
+        if (count - i >= 4) {
+          __m256d lanes{_mm256_set1_pd(best)};
+          for (; i + 4 <= count; i += 4) lanes = _mm256_max_pd(_mm256_loadu_pd(values + i), lanes);
+          alignas(32) double out[4];
+          _mm256_store_pd(out, lanes);
+          best = std::max({out[0], out[1], out[2], out[3]});
+        }
+      } else if constexpr (std::is_same_v<T, float>) {
+        if (count - i >= 8) {
+          __m256 lanes{_mm256_set1_ps(best)};
+          for (; i + 8 <= count; i += 8) lanes = _mm256_max_ps(_mm256_loadu_ps(values + i), lanes);
+          alignas(32) float out[8];
+          _mm256_store_ps(out, lanes);
+          best = *std::max_element(out, out + 8);
+        }
+      } else if constexpr ((std::is_same_v<T, std::int32_t> || std::is_same_v<T, std::uint32_t>)) {
+        if (count >= 8) {
+          const auto load = [values](std::size_t at) { return _mm256_loadu_si256(reinterpret_cast<const __m256i*>(values + at)); };
+          __m256i lanes{load(0)};
+          for (i = 8; i + 8 <= count; i += 8) {
+            lanes = std::is_signed_v<T> ? _mm256_max_epi32(lanes, load(i)) : _mm256_max_epu32(lanes, load(i));
+          }
+          alignas(32) T out[8];
+          _mm256_store_si256(reinterpret_cast<__m256i*>(out), lanes);
+          best = *std::max_element(out, out + 8);
+        }
+      }
+    #endif // __AVX2__
+
+    for (; i < count; ++i) {
+      if (values[i] > best) best = values[i];
+    }
+    return best;
+  }
+
+  // 'MaxValue' of 'count' > 0 values, split across threads for large inputs.
+  template<typename T>
+  T MaxArithmetic(const T* values, std::size_t count) {
+    if (count < 2 * kMinElementsPerWorker) return MaxValue(values, count); // One slice: skip the thread bookkeeping
+
+    const std::vector<T> maxima{MapSlices<T>(count, kMinElementsPerWorker, [values](std::size_t begin, std::size_t end) {
+      return begin < end ? MaxValue(values + begin, end - begin) : values[0];
+    })};
+    return MaxValue(maxima.data(), maxima.size());
+  }
+
+  // Index of the first largest of 'count' arithmetic values: the max by the kernels above, then the first
+  // position holding it - both split across threads for large inputs. NaNs are skipped; 0 if every value
+  // is NaN or 'count' is 0, so a non-empty range always gets a valid index.
+  template<typename T>
+  std::size_t ArgmaxArithmetic(const T* values, std::size_t count) {
+    if (count == 0) return 0;
+    const T best{MaxArithmetic(values, count)};
+    if (best != best) return 0; // Every value is NaN
+
+    if (count < 2 * kMinElementsPerWorker) {
+      return static_cast<std::size_t>(std::find(values, values + count, best) - values);
+    }
+    const std::vector<std::size_t> positions{MapSlices<std::size_t>(count, kMinElementsPerWorker, [values, best](std::size_t begin, std::size_t end) {
+      return static_cast<std::size_t>(std::find(values + begin, values + end, best) - values);
+    })};
+    for (std::size_t i{0}; i < positions.size(); ++i) {
+      if (positions[i] < count && values[positions[i]] == best) return positions[i];
+    }
+    return 0; // Unreachable: 'best' is one of the values
+  }
+
+  template<typename Range, typename = void>
+  struct IsContiguousArithmetic : std::false_type {};
+
+  template<typename Range>
+  struct IsContiguousArithmetic<Range, std::void_t<decltype(std::data(std::declval<const Range&>())), decltype(std::size(std::declval<const Range&>()))>>
+      : std::is_arithmetic<std::remove_cv_t<std::remove_pointer_t<decltype(std::data(std::declval<const Range&>()))>>> {};
+
+  // Position of the first largest element of any range (0 if empty):
+  // contiguous arithmetic ranges ('std::vector<double>', arrays, ...) take the SIMD/parallel path,
+  // anything else (strings, custom types) one pass with 'operator>'.
+  template<typename Range>
+  std::size_t argmax(const Range& range) {
+    if constexpr (IsContiguousArithmetic<Range>::value) {
+      return ArgmaxArithmetic(std::data(range), std::size(range));
+    } else {
+      auto it = std::begin(range);
+      const auto end = std::end(range);
+      std::size_t index{0};
+      std::size_t best_index{0};
+      if (it == end) return 0;
+
+      auto best = it;
+      for (++it, ++index; it != end; ++it, ++index) {
+        if (*it > *best) {
+          best = it;
+          best_index = index;
+        }
+      }
+      return best_index;
+    }
+  }
+
+  // Largest element; 'range' must not be empty. Contiguous arithmetic ranges get the value straight from
+  // the max kernel (NaNs skipped, as in 'argmax'); anything else is returned by reference.
+  template<typename Range>
+  decltype(auto) max_of(const Range& range) {
+    if constexpr (IsContiguousArithmetic<Range>::value) {
+      return MaxArithmetic(std::data(range), std::size(range));
+    } else {
+      return *std::next(std::begin(range), static_cast<std::ptrdiff_t>(argmax(range)));
+    }
+  }
+}
+
+#endif // COMMON_REDUCE_H
@@ -0,0 +1,344 @@
+// snapshot.h
+// Versioned binary snapshots of the exercises' columnar (SoA) stores. A snapshot is written once from a
+// store and loaded by mapping the whole file read-only: every column is already laid out as the
+// in-memory array, so loading is a header check and the views hand out pointers into the mapping.
+// Nothing is parsed or copied, and the OS pages the data in as it is touched.
+//
+// Usage (from any exercise): #include "../common/snapshot.h"
+//   snapshot::Write(path, snapshot::Kind("SPHR"), rows, {snapshot::ColumnOf(m_radii)});
+//   auto opened = snapshot::MappedSnapshot::Open(path, snapshot::Kind("SPHR"));
+//   if (auto* error = std::get_if<std::error_code>(&opened)) { ... }
+//   const double* radii{std::get<snapshot::MappedSnapshot>(opened).Column<double>(0, rows)};
+//
+// Layout, all integers in host byte order (a byte-order mark rejects files from the other endianness):
+//   Header       64 bytes: magic "SNAPSHOT", format version, byte-order mark, store kind, column count,
+//                row count and total file size.
+//   Column table one 24-byte 'ColumnEntry' (offset, size in bytes, element size) per column.
+//   Columns      each starting at a multiple of 'kAlignment' bytes, so any element type (and a 32-byte
+//                AVX2 load) is naturally aligned in the mapping.
+// Only the layout is validated when opening; the contents are trusted, as 'Write' produced them. Views that
+// slice a character column by stored offsets check those offsets once in their own 'Open'.
+// <!> Bump 'kVersion' whenever a store changes its columns or their element types.
+
+#ifndef COMMON_SNAPSHOT_H
+#define COMMON_SNAPSHOT_H
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <initializer_list>
+#include <string>
+#include <system_error>
+#include <type_traits>
+#include <utility>
+#include <variant>
+#include <vector>
+
+#if defined(_WIN32)
+  // Without these, 'windows.h' defines 'min'/'max' macros that break 'std::min' and 'numeric_limits<T>::max()'
+  // in every exercise including this header, and pulls in most of the Win32 API besides the mapping calls.
+  #ifndef NOMINMAX
+    #define NOMINMAX
+  #endif // NOMINMAX
+  #ifndef WIN32_LEAN_AND_MEAN
+    #define WIN32_LEAN_AND_MEAN
+  #endif // WIN32_LEAN_AND_MEAN
+  #include <windows.h>
+#else
+  #include <fcntl.h>
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <unistd.h>
+#endif // _WIN32
+
+namespace snapshot {
+  constexpr std::uint32_t kVersion{1};
+  constexpr std::uint32_t kByteOrderMark{0x0102'0304};
+  constexpr std::size_t kAlignment{64};
+  constexpr char kMagic[8]{'S', 'N', 'A', 'P', 'S', 'H', 'O', 'T'};
+
+  // Four-character tag of the store a snapshot holds, e.g. 'Kind("SPHR")'.
+  constexpr std::uint32_t Kind(const char (&name)[5]) {
+    return static_cast<std::uint32_t>(static_cast<unsigned char>(name[0])) |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(name[1])) << 8 |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(name[2])) << 16 |
+           static_cast<std::uint32_t>(static_cast<unsigned char>(name[3])) << 24;
+  }
+
+  struct Header {
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byte_order;
+    std::uint32_t kind;
+    std::uint32_t column_count;
+    std::uint64_t rows;
+    std::uint64_t file_size;
+    std::uint8_t reserved[24];
+  };
+
+  struct ColumnEntry {
+    std::uint64_t offset;       // From the start of the file
+    std::uint64_t bytes;
+    std::uint32_t element_size;
+    std::uint32_t reserved;
+  };
+
+  static_assert(sizeof(Header) == 64 && sizeof(ColumnEntry) == 24, "The snapshot layout must not depend on the compiler");
+
+  // Why 'Open' rejected a file; system errors (missing file, ...) come as 'std::system_category' codes.
+  enum class Error {
+    BadMagic = 1,
+    UnsupportedVersion,
+    WrongByteOrder,
+    WrongKind,
+    Truncated,
+    BadColumn
+  };
+
+  class ErrorCategory final : public std::error_category {
+    public:
+      const char* name() const noexcept override { return "snapshot"; }
+
+      std::string message(int error) const override {
+        switch (static_cast<Error>(error)) {
+          case Error::BadMagic: return "Not a snapshot file.";
+          case Error::UnsupportedVersion: return "Snapshot was written by another format version.";
+          case Error::WrongByteOrder: return "Snapshot was written on a machine of the other byte order.";
+          case Error::WrongKind: return "Snapshot holds another kind of store.";
+          case Error::Truncated: return "Snapshot is truncated.";
+          case Error::BadColumn: return "Snapshot columns do not match the store.";
+        }
+        return "Unknown snapshot error.";
+      }
+  };
+
+  inline const std::error_category& Category() noexcept {
+    static const ErrorCategory category;
+    return category;
+  }
+
+  inline std::error_code make_error_code(Error error) noexcept {
+    return std::error_code(static_cast<int>(error), Category());
+  }
+
+  // One column to write: 'count' elements of 'element_size' bytes at 'data'.
+  struct ColumnSource {
+    const void* data;
+    std::size_t count;
+    std::size_t element_size;
+  };
+
+  template<typename T>
+  ColumnSource ColumnOf(const T* data, std::size_t count) {
+    static_assert(std::is_trivially_copyable_v<T>, "Snapshot columns are written and mapped byte for byte");
+    return ColumnSource{data, count, sizeof(T)};
+  }
+
+  template<typename T>
+  ColumnSource ColumnOf(const std::vector<T>& values) { return ColumnOf(values.data(), values.size()); }
+
+  inline ColumnSource ColumnOf(const std::string& characters) { return ColumnOf(characters.data(), characters.size()); }
+
+  inline std::uint64_t AlignUp(std::uint64_t offset) {
+    return (offset + kAlignment - 1) / kAlignment * kAlignment;
+  }
+
+  // Writes a snapshot of 'rows' rows to 'path'. The data goes to '<path>.tmp' first and is renamed over
+  // 'path' once complete, so a failed or interrupted write never leaves a half-written snapshot behind.
+  inline std::error_code Write(const std::string& path, std::uint32_t kind, std::size_t rows, std::initializer_list<ColumnSource> columns) {
+    Header header{};
+    std::memcpy(header.magic, kMagic, sizeof(kMagic));
+    header.version = kVersion;
+    header.byte_order = kByteOrderMark;
+    header.kind = kind;
+    header.column_count = static_cast<std::uint32_t>(columns.size());
+    header.rows = rows;
+
+    std::vector<ColumnEntry> entries;
+    entries.reserve(columns.size());
+    std::uint64_t offset{sizeof(Header) + columns.size() * sizeof(ColumnEntry)};
+    for (const ColumnSource& column : columns) {
+      offset = AlignUp(offset);
+      entries.push_back(ColumnEntry{offset, column.count * column.element_size, static_cast<std::uint32_t>(column.element_size), 0});
+      offset += entries.back().bytes;
+    }
+    header.file_size = offset;
+
+    const std::string temporary{path + ".tmp"};
+    errno = 0;
+    std::FILE* file{std::fopen(temporary.c_str(), "wb")};
+    if (!file) return std::error_code(errno, std::generic_category());
+
+    static constexpr char kPadding[kAlignment]{};
+    bool written{std::fwrite(&header, sizeof(header), 1, file) == 1 &&
+                 (entries.empty() || std::fwrite(entries.data(), sizeof(ColumnEntry), entries.size(), file) == entries.size())};
+    std::uint64_t position{sizeof(Header) + entries.size() * sizeof(ColumnEntry)};
+    std::size_t index{0};
+    for (const ColumnSource& column : columns) {
+      const ColumnEntry& entry{entries[index++]};
+      const auto padding = static_cast<std::size_t>(entry.offset - position);
+      written = written && std::fwrite(kPadding, 1, padding, file) == padding;
+      written = written && (entry.bytes == 0 || std::fwrite(column.data, 1, entry.bytes, file) == entry.bytes);
+      position = entry.offset + entry.bytes;
+    }
+
+    const int write_error{errno};
+    written = std::fclose(file) == 0 && written; // 'fclose' flushes, so it can fail too
+    if (!written) {
+      std::remove(temporary.c_str());
+      return std::error_code(write_error ? write_error : EIO, std::generic_category());
+    }
+
+    std::error_code error;
+    std::filesystem::rename(temporary, path, error); // Replaces an existing snapshot
+    if (error) std::remove(temporary.c_str());
+    return error;
+  }
+
+  // A whole snapshot file mapped read-only, checked against the expected store kind on 'Open'.
+  // Move-only; every pointer from 'Column' stays valid for as long as the object lives.
+  class MappedSnapshot {
+    public:
+      static std::variant<MappedSnapshot, std::error_code> Open(const std::string& path, std::uint32_t kind) {
+        MappedSnapshot snapshot;
+        if (const std::error_code error{snapshot.Map(path)}) return error;
+        if (const std::error_code error{snapshot.Check(kind)}) return error;
+        return snapshot;
+      }
+
+      MappedSnapshot(MappedSnapshot&& other) noexcept { Swap(other); }
+      MappedSnapshot& operator=(MappedSnapshot&& other) noexcept { Swap(other); return *this; }
+      MappedSnapshot(const MappedSnapshot&) = delete;
+      MappedSnapshot& operator=(const MappedSnapshot&) = delete;
+
+      ~MappedSnapshot() noexcept {
+        #if defined(_WIN32)
+          if (m_data) UnmapViewOfFile(m_data);
+        #else
+          if (m_data) ::munmap(const_cast<char*>(m_data), m_size);
+        #endif // _WIN32
+      }
+
+    // Getters
+      std::size_t Rows() const noexcept { return static_cast<std::size_t>(GetHeader().rows); }
+      std::size_t Columns() const noexcept { return GetHeader().column_count; }
+      std::uint64_t FileSize() const noexcept { return m_size; }
+
+      // Number of elements in column 'index' (0 if there is no such column).
+      std::size_t Elements(std::size_t index) const noexcept {
+        if (index >= Columns()) return 0;
+        const ColumnEntry& entry{Entry(index)};
+        return static_cast<std::size_t>(entry.bytes / entry.element_size);
+      }
+
+      // Column 'index' as 'count' values of 'T'; 'nullptr' if its element size or length differ.
+      template<typename T>
+      const T* Column(std::size_t index, std::size_t count) const noexcept {
+        static_assert(std::is_trivially_copyable_v<T>, "Snapshot columns are written and mapped byte for byte");
+        if (index >= Columns() || Entry(index).element_size != sizeof(T) || Elements(index) != count) return nullptr;
+        return reinterpret_cast<const T*>(m_data + Entry(index).offset); // Never 'nullptr', even for an empty column
+      }
+
+    private:
+      MappedSnapshot() = default;
+
+      const Header& GetHeader() const noexcept { return *reinterpret_cast<const Header*>(m_data); }
+      const ColumnEntry& Entry(std::size_t index) const noexcept {
+        return reinterpret_cast<const ColumnEntry*>(m_data + sizeof(Header))[index];
+      }
+
+      static std::error_code LastError() {
+        #if defined(_WIN32)
+          return std::error_code(static_cast<int>(GetLastError()), std::system_category());
+        #else
+          return std::error_code(errno, std::system_category());
+        #endif // _WIN32
+      }
+
+      // The file handles are closed straight away: the mapping keeps the data reachable on its own.
+      std::error_code Map(const std::string& path) {
+        #if defined(_WIN32)
+          const HANDLE file{CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING,
+                                        FILE_ATTRIBUTE_NORMAL, nullptr)};
+          if (file == INVALID_HANDLE_VALUE) return LastError();
+
+          LARGE_INTEGER size;
+          if (!GetFileSizeEx(file, &size)) {
+            const std::error_code error{LastError()};
+            CloseHandle(file);
+            return error;
+          }
+          m_size = static_cast<std::size_t>(size.QuadPart);
+          if (m_size < sizeof(Header)) { // Also avoids mapping an empty file, which fails on Windows
+            CloseHandle(file);
+            return make_error_code(Error::Truncated);
+          }
+
+          const HANDLE mapping{CreateFileMappingA(file, nullptr, PAGE_READONLY, 0, 0, nullptr)};
+          std::error_code error{mapping ? std::error_code() : LastError()};
+          if (mapping) {
+            m_data = static_cast<const char*>(MapViewOfFile(mapping, FILE_MAP_READ, 0, 0, 0));
+            if (!m_data) error = LastError();
+            CloseHandle(mapping);
+          }
+          CloseHandle(file);
+          return error;
+        #else
+          const int descriptor{::open(path.c_str(), O_RDONLY)};
+          if (descriptor < 0) return LastError();
+
+          struct stat info;
+          std::error_code error;
+          if (::fstat(descriptor, &info) != 0) {
+            error = LastError();
+          } else if (static_cast<std::uint64_t>(info.st_size) < sizeof(Header)) {
+            error = make_error_code(Error::Truncated);
+          } else {
+            m_size = static_cast<std::size_t>(info.st_size);
+            void* data{::mmap(nullptr, m_size, PROT_READ, MAP_SHARED, descriptor, 0)};
+            if (data == MAP_FAILED) error = LastError();
+            else m_data = static_cast<const char*>(data);
+          }
+          ::close(descriptor);
+          return error;
+        #endif // _WIN32
+      }
+
+      std::error_code Check(std::uint32_t kind) const {
+        const Header& header{GetHeader()};
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) return make_error_code(Error::BadMagic);
+        if (header.byte_order != kByteOrderMark) return make_error_code(Error::WrongByteOrder);
+        if (header.version != kVersion) return make_error_code(Error::UnsupportedVersion);
+        if (header.kind != kind) return make_error_code(Error::WrongKind);
+        if (header.file_size != m_size) return make_error_code(Error::Truncated);
+        if (header.column_count > (m_size - sizeof(Header)) / sizeof(ColumnEntry)) return make_error_code(Error::Truncated);
+
+        for (std::size_t i{0}; i < header.column_count; ++i) {
+          const ColumnEntry& entry{Entry(i)};
+          if (entry.offset % kAlignment != 0 || entry.offset > m_size || entry.bytes > m_size - entry.offset) {
+            return make_error_code(Error::Truncated);
+          }
+          if (entry.element_size == 0 || entry.bytes % entry.element_size != 0) return make_error_code(Error::BadColumn);
+        }
+        return std::error_code();
+      }
+
+      void Swap(MappedSnapshot& other) noexcept {
+        std::swap(m_data, other.m_data);
+        std::swap(m_size, other.m_size);
+      }
+
+      const char* m_data{nullptr};
+      std::size_t m_size{0};
+  };
+}
+
+namespace std {
+  template<>
+  struct is_error_code_enum<snapshot::Error> : true_type {};
+}
+
+#endif // COMMON_SNAPSHOT_H
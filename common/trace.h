@@ -0,0 +1,234 @@
+// trace.h
+// Shared tracing layer for the exercises: object lifecycle events and scoped timings, written as a
+// Chrome trace (open the file in chrome://tracing or https://ui.perfetto.dev).
+// <!> Compiled out unless built with -DENABLE_TRACING: the macros below then expand to nothing.
+//
+// Usage (from any exercise): #include "../common/trace.h"
+//   TRACE_OBJECT_CREATED("Car", this);    // In a constructor
+//   TRACE_OBJECT_DESTROYED("Car", this);  // In the destructor
+//   TRACE_SCOPE("Sort");                  // Times the enclosing block
+// Names must be string literals (they are stored by pointer and written without escaping).
+// Implicit copies and moves are not traced, so such an object shows a destruction without a creation.
+// The output file is 'trace.json', or the path in the 'TRACE_FILE' environment variable.
+
+#ifndef COMMON_TRACE_H
+#define COMMON_TRACE_H
+
+#if defined(ENABLE_TRACING)
+  #define TRACE_ENABLED 1
+#else
+  #define TRACE_ENABLED 0
+#endif // ENABLE_TRACING
+
+#if TRACE_ENABLED
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <deque>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+namespace trace {
+  struct Event {
+    const char* name;
+    const char* category;
+    std::uintptr_t id;          // Object address for lifecycle events
+    std::uint64_t timestamp_ns; // Since the tracer started
+    std::uint64_t duration_ns;  // Scoped timings only
+    std::uint32_t thread;
+    char phase;                 // 'b'/'e': object created/destroyed, 'X': timed scope
+  };
+
+  // Owns the output file and a writer thread. Threads record into their own buffers and hand over
+  // full chunks, so the traced code never formats or writes anything itself.
+  class Tracer {
+    public:
+      static Tracer& Instance() {
+        static Tracer tracer;
+        return tracer;
+      }
+
+      Tracer(const Tracer&) = delete;
+      Tracer& operator=(const Tracer&) = delete;
+
+      ~Tracer() {
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_stopping = true;
+        }
+        m_wake.notify_one();
+        m_writer.join();
+        s_alive.store(false, std::memory_order_release);
+
+        if (m_file) {
+          std::fputs("\n]\n", m_file);
+          std::fclose(m_file);
+        }
+      }
+
+      void Submit(std::vector<Event>&& chunk) {
+        {
+          std::lock_guard<std::mutex> lock(m_mutex);
+          m_pending.push_back(std::move(chunk));
+        }
+        m_wake.notify_one();
+      }
+
+      std::uint32_t RegisterThread() noexcept {
+        return m_next_thread.fetch_add(1, std::memory_order_relaxed);
+      }
+
+      std::uint64_t Now() const noexcept {
+        return static_cast<std::uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::steady_clock::now() - m_start).count());
+      }
+
+      static bool IsAlive() noexcept {
+        return s_alive.load(std::memory_order_acquire);
+      }
+
+    private:
+      Tracer() : m_start(std::chrono::steady_clock::now()) {
+        const char* path{std::getenv("TRACE_FILE")};
+        m_file = std::fopen(path ? path : "trace.json", "w");
+        if (m_file) std::fputs("[\n", m_file);
+
+        m_writer = std::thread([this] { WriterLoop(); });
+        s_alive.store(true, std::memory_order_release);
+      }
+
+      void WriterLoop() {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        for (;;) {
+          m_wake.wait(lock, [this] { return m_stopping || !m_pending.empty(); });
+          if (m_pending.empty()) return; // Stopping, and everything is written
+
+          std::vector<Event> chunk{std::move(m_pending.front())};
+          m_pending.pop_front();
+          lock.unlock();
+          Write(chunk);
+          lock.lock();
+        }
+      }
+
+      void Write(const std::vector<Event>& chunk) {
+        if (!m_file) return;
+
+        for (const Event& event : chunk) {
+          std::fputs(m_first ? "" : ",\n", m_file);
+          m_first = false;
+
+          const double timestamp_us{static_cast<double>(event.timestamp_ns) / 1'000.0};
+          if (event.phase == 'X') {
+            std::fprintf(m_file, R"({"name":"%s","cat":"%s","ph":"X","ts":%.3f,"dur":%.3f,"pid":1,"tid":%u})",
+                         event.name, event.category, timestamp_us, static_cast<double>(event.duration_ns) / 1'000.0,
+                         static_cast<unsigned int>(event.thread));
+          } else {
+            std::fprintf(m_file, R"({"name":"%s","cat":"%s","ph":"%c","id":"0x%llx","ts":%.3f,"pid":1,"tid":%u})",
+                         event.name, event.category, event.phase, static_cast<unsigned long long>(event.id),
+                         timestamp_us, static_cast<unsigned int>(event.thread));
+          }
+        }
+      }
+
+      inline static std::atomic<bool> s_alive{false};
+
+      std::chrono::steady_clock::time_point m_start;
+      std::FILE* m_file{nullptr};
+      bool m_first{true};
+
+      std::mutex m_mutex;
+      std::condition_variable m_wake;
+      std::deque<std::vector<Event>> m_pending;
+      bool m_stopping{false};
+      std::atomic<std::uint32_t> m_next_thread{1};
+      std::thread m_writer;
+  };
+
+  // Per-thread event buffer: recording is a 'push_back' into memory only this thread touches.
+  class ThreadBuffer {
+    public:
+      static constexpr std::size_t kChunkEvents{4'096};
+
+      ThreadBuffer() : m_thread(Tracer::Instance().RegisterThread()) {
+        m_events.reserve(kChunkEvents);
+      }
+
+      ~ThreadBuffer() {
+        Flush();
+        Destroyed() = true;
+      }
+
+      // Events recorded during static destruction (after the tracer or this buffer is gone) are dropped.
+      static void Record(Event event) {
+        if (Destroyed() || !Tracer::IsAlive()) return;
+
+        thread_local ThreadBuffer buffer;
+        event.thread = buffer.m_thread;
+        buffer.m_events.push_back(event);
+        if (buffer.m_events.size() == kChunkEvents) buffer.Flush();
+      }
+
+    private:
+      static bool& Destroyed() noexcept {
+        thread_local bool destroyed{false}; // Trivially destructible, so still readable after '~ThreadBuffer'
+        return destroyed;
+      }
+
+      void Flush() {
+        if (m_events.empty() || !Tracer::IsAlive()) return;
+
+        std::vector<Event> chunk;
+        chunk.reserve(kChunkEvents);
+        chunk.swap(m_events);
+        Tracer::Instance().Submit(std::move(chunk));
+      }
+
+      std::uint32_t m_thread;
+      std::vector<Event> m_events;
+  };
+
+  inline void RecordObject(const char* name, const void* object, char phase) {
+    Tracer::Instance(); // Starts the tracer (and its clock) before the first event
+    ThreadBuffer::Record(Event{name, "lifecycle", reinterpret_cast<std::uintptr_t>(object), Tracer::Instance().Now(), 0, 0, phase});
+  }
+
+  class ScopedTimer {
+    public:
+      explicit ScopedTimer(const char* name) : m_name(name), m_start(Tracer::Instance().Now()) {}
+      ScopedTimer(const ScopedTimer&) = delete;
+      ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+      ~ScopedTimer() {
+        const std::uint64_t end{Tracer::Instance().Now()};
+        ThreadBuffer::Record(Event{m_name, "scope", 0, m_start, end - m_start, 0, 'X'});
+      }
+
+    private:
+      const char* m_name;
+      std::uint64_t m_start;
+  };
+}
+
+#define TRACE_CONCAT_INNER(a, b) a##b
+#define TRACE_CONCAT(a, b) TRACE_CONCAT_INNER(a, b)
+
+#define TRACE_OBJECT_CREATED(name, object) ::trace::RecordObject(name, object, 'b')
+#define TRACE_OBJECT_DESTROYED(name, object) ::trace::RecordObject(name, object, 'e')
+#define TRACE_SCOPE(name) const ::trace::ScopedTimer TRACE_CONCAT(trace_scope_, __LINE__){name}
+
+#else
+
+#define TRACE_OBJECT_CREATED(name, object) static_cast<void>(0)
+#define TRACE_OBJECT_DESTROYED(name, object) static_cast<void>(0)
+#define TRACE_SCOPE(name) static_cast<void>(0)
+
+#endif // TRACE_ENABLED
+
+#endif // COMMON_TRACE_H